@@ -36,66 +36,6 @@
 #define DRD_EXEC_STOP
 #endif
 
-void setupAll() {
-#if defined USE_BLYNK
-    BlynkSync::getInstance().setup();
-#endif
-#if defined USE_MQTT && !defined USE_MQTT_HOME_ASSISTANT
-    MqttSync::getInstance().setup();
-#endif
-#if defined USE_MQTT_HOME_ASSISTANT
-    MqttHASync::getInstance().setup();
-#endif
-}
-
-void connectAll() {
-#if defined USE_BLYNK
-    BlynkSync::getInstance().connect();
-#endif
-#if defined USE_MQTT && !defined USE_MQTT_HOME_ASSISTANT
-    MqttSync::getInstance().connect();
-#endif
-#if defined USE_MQTT_HOME_ASSISTANT
-    // not needed
-    // MqttHASync::getInstance().connect();
-#endif
-}
-
-void uploadRealtimeAll() {
-#if defined USE_BLYNK
-    BlynkSync::getInstance().uploadRealtimeToBlynk();
-#endif
-#if defined USE_MQTT && !defined USE_MQTT_HOME_ASSISTANT
-    MqttSync::getInstance().uploadRealtimeToMqtt();
-#endif
-#if defined USE_MQTT_HOME_ASSISTANT
-    MqttHASync::getInstance().uploadRealtimeToMqtt();
-#endif
-}
-void uploadStatsAll() {
-#if defined USE_BLYNK
-    BlynkSync::getInstance().uploadStatsToBlynk();
-#endif
-#if defined USE_MQTT && !defined USE_MQTT_HOME_ASSISTANT
-    MqttSync::getInstance().uploadStatsToMqtt();
-#endif
-#if defined USE_MQTT_HOME_ASSISTANT
-    MqttHASync::getInstance().uploadStatsToMqtt();
-#endif
-}
-
-void loopAll() {
-#if defined USE_BLYNK
-    BlynkSync::getInstance().loop();
-#endif
-#if defined USE_MQTT && !defined USE_MQTT_HOME_ASSISTANT
-    MqttSync::getInstance().loop();
-#endif
-#if defined USE_MQTT_HOME_ASSISTANT
-    MqttHASync::getInstance().loop();
-#endif
-}
-
 bool configWiFi() {
     const EnvironrmentData *envData = Environment::getData();
 
@@ -195,7 +135,7 @@ void loop() {
 #ifdef USE_OTA_UPDATE
     ArduinoOTA.handle();
 #endif
-    loopAll();
+    SyncRegistry::loopAll();
 }
 
 void setup() {
@@ -306,7 +246,12 @@ void setup() {
 
 #ifdef USE_EXTERNAL_HEAVY_LOAD_CURRENT_METER
     LoadCurrentOverwrite::setup(Controller::getInstance().getSolarController());
-    Controller::getInstance().getSolarController()->setOnUpdateRunCompleted([]() { LoadCurrentOverwrite::overWrite(Controller::getInstance().getSolarController()); });
+    Controller::getInstance().getMainTimer()->setInterval(EXTERNAL_HEAVY_LOAD_CURRENT_METER_UPDATE_MS_PERIOD, LoadCurrentOverwrite::overWrite);
+#endif
+
+#ifdef USE_VARIABLE_HISTORY
+    VariableHistory::setup(Controller::getInstance().getSolarController());
+    Controller::getInstance().getMainTimer()->setInterval(VARIABLE_HISTORY_MS_PERIOD, VariableHistory::sample);
 #endif
 
 #ifdef USE_NTP_SERVER
@@ -316,7 +261,31 @@ void setup() {
         debugPrintf(true, "My NOW is: %i-%02i-%02i %02i:%02i:%02i", ti->tm_year + 1900, ti->tm_mon + 1, ti->tm_mday, ti->tm_hour, ti->tm_min, ti->tm_sec);
     }
 #endif
-    setupAll();
+
+#ifdef USE_VARIABLE_ROLLUP
+    // windows follow the local time, if available
+    VariableRollup::setup(Controller::getInstance().getSolarController());
+    Controller::getInstance().getMainTimer()->setInterval(VARIABLE_ROLLUP_MS_PERIOD, VariableRollup::update);
+#endif
+#ifdef USE_VARIABLE_RULES
+    VariableRules::setup(Controller::getInstance().getSolarController());
+#endif
+    if (strlen(Environment::getData()->publishPolicy) > 0) {
+        debugPrintf(true, "%i publish policies set", VariableDefiner::getInstance().setPublishPolicies(Environment::getData()->publishPolicy));
+    }
+#ifdef USE_BLYNK
+    SyncRegistry::add("blynk", []() -> BaseSync & { return BlynkSync::getInstance(); });
+#endif
+#if defined(USE_MQTT_RAW_TOPICS) && defined(USE_MQTT_HOME_ASSISTANT)
+    // the broker connection is begun and polled by MqttHASync
+    SyncRegistry::add("mqtt", []() -> BaseSync & { return MqttSync::getInstance(); }, "mqtt-ha");
+#elif defined(USE_MQTT_RAW_TOPICS)
+    SyncRegistry::add("mqtt", []() -> BaseSync & { return MqttSync::getInstance(); });
+#endif
+#if defined(USE_MQTT) && defined(USE_MQTT_HOME_ASSISTANT)
+    SyncRegistry::add("mqtt-ha", []() -> BaseSync & { return MqttHASync::getInstance(); });
+#endif
+    SyncRegistry::setupAll();
 
     debugPrintf(true, Text::setupWithName, "Solar controller");
 #ifdef SYNC_ST_TIME
@@ -332,8 +301,8 @@ void setup() {
 
     delay(1000);
     debugPrintln("Sync all values");
-    uploadRealtimeAll();
-    uploadStatsAll();
+    SyncRegistry::uploadRealtimeAll();
+    SyncRegistry::uploadStatsAll();
     delay(1000);
 
     // periodically refresh tracer values
@@ -348,11 +317,31 @@ void setup() {
                                                           {
                                                             debugPrintf(true, Text::errorWithCodeInt, STATUS_ERR_SOLAR_TRACER_NO_COMMUNICATION, Controller::getInstance().getSolarController()->getLastControllerCommunicationStatus());
                                                             Controller::getInstance().setErrorFlag(STATUS_ERR_SOLAR_TRACER_NO_COMMUNICATION, true);
-                                                          } });
+                                                          }
+#ifdef USE_VARIABLE_RULES
+                                                          // act on the thresholds crossed by this update, also when offline
+                                                          VariableRules::apply();
+#endif
+#ifdef USE_SYNC_ADAPTIVE_CADENCE
+                                                          BaseSync::sampleChangeRates();
+#endif
+#ifdef USE_SYNC_ON_CHANGE
+                                                          // publish what the block just read has changed
+                                                          SyncRegistry::uploadRealtimeOnChangeAll();
+#endif
+                                                          });
     // periodically send STATS all value to blynk
-    Controller::getInstance().getMainTimer()->setInterval(SYNC_STATS_MS_PERIOD, uploadStatsAll);
+    Controller::getInstance().getMainTimer()->setInterval(SYNC_STATS_MS_PERIOD, SyncRegistry::uploadStatsAll);
     // periodically send REALTIME  value to blynk
-    Controller::getInstance().getMainTimer()->setInterval(SYNC_REALTIME_MS_PERIOD, uploadRealtimeAll);
+#if defined(USE_SYNC_ADAPTIVE_CADENCE) && SYNC_ADAPTIVE_MIN_MS < SYNC_REALTIME_MS_PERIOD
+    // publishes are spaced by the adaptive interval of each variable
+    Controller::getInstance().getMainTimer()->setInterval(SYNC_ADAPTIVE_MIN_MS, SyncRegistry::uploadRealtimeAll);
+#else
+    Controller::getInstance().getMainTimer()->setInterval(SYNC_REALTIME_MS_PERIOD, SyncRegistry::uploadRealtimeAll);
+#endif
+#ifdef USE_SYNC_DIAGNOSTICS
+    Controller::getInstance().getMainTimer()->setInterval(SYNC_DIAGNOSTICS_MS_PERIOD, SyncRegistry::sendDiagnosticsAll);
+#endif
     // esp watchddog
     Controller::getInstance().getMainTimer()->setInterval(5000, watchDog);
 
@@ -58,7 +58,7 @@
  * Define the communication parameters for the
  * solar tracer
  */
-// solar tracer model
+// solar tracer model (EPEVER_SOLAR_TRACER_AUTO: detect the register map at boot, one image for every EPEVER model)
 #define SOLAR_TRACER_MODEL EPEVER_SOLAR_TRACER_A
 // use serial as communication interfce
 #define USE_SERIAL_STREAM
@@ -117,11 +117,34 @@
   #define EXTERNAL_HEAVY_LOAD_CURRENT_METER_VOLTAGE_ZERO_AMP_VOLT 0.009
   // Volt/Ampere ratio
   #define EXTERNAL_HEAVY_LOAD_CURRENT_METER_VOLTAGE_AMP_VOLT 4/100.0
+  // consumed energy is saved to flash every 30 minutes and at day change (at most this energy is lost on reboot)
+  #define EXTERNAL_HEAVY_LOAD_ENERGY_CHECKPOINT_MS_PERIOD 1800000L
 #endif
 
 // How many ms between each refresh request 
 //#define CONTROLLER_UPDATE_MS_PERIOD 2000L
 
+// keep a compressed history of some variables in RAM, published over MQTT on request (see MQTT_HISTORY_REQUEST_TOPIC)
+//#define USE_VARIABLE_HISTORY
+#ifdef USE_VARIABLE_HISTORY
+  #define VARIABLE_HISTORY_VARIABLES Variable::PV_POWER, Variable::BATTERY_VOLTAGE
+  // memory for each variable is TIME_SERIES_BLOCK_COUNT * TIME_SERIES_BLOCK_SIZE bytes,
+  // about 1 hour of 2s samples for a noisy battery voltage, 30 minutes for a noisy pv power
+  #define TIME_SERIES_BLOCK_SIZE 256
+  #define TIME_SERIES_BLOCK_COUNT 6
+  // ms between 2 samples, default CONTROLLER_UPDATE_MS_PERIOD
+  //#define VARIABLE_HISTORY_MS_PERIOD 2000L
+#endif
+
+// min/max/avg/energy of realtime variables over minute/hour/day windows, see ROLLUP_VARIABLE_LIST
+// (day windows follow the local time when USE_NTP_SERVER is enabled, the uptime otherwise)
+//#define USE_VARIABLE_ROLLUP
+
+// threshold rules run on the board (load switch, alarms) also when the servers are unreachable,
+// read from /rules.json in LittleFS, see VariableRules.h. Actions run after each controller update (CONTROLLER_UPDATE_MS_PERIOD),
+// Blynk alarms need USE_BLYNK_2 (BLYNK_ALARM_EVENT)
+//#define USE_VARIABLE_RULES
+
  /*
   * TIME SYNC
   */
@@ -223,6 +246,51 @@
 // How many ms between each stat sync to blynk server
 #define SYNC_STATS_MS_PERIOD 720000L
 
+// servers not synced, comma separated names: blynk, mqtt, mqtt-ha (can be changed from the configuration portal),
+// disabling mqtt-ha disables mqtt too when they share the connection (USE_MQTT_HOME_ASSISTANT_RAW_TOPICS)
+#define SYNC_DISABLED ""
+
+// publish policies replacing VARIABLE_PUBLISH_POLICY_LIST (can be changed from the configuration portal), comma separated
+// VARIABLE:deadband[%][:min seconds between 2 updates[:max seconds without update]] eg: "PV_POWER:5:10:300,BATTERY_VOLTAGE:1%"
+#define PUBLISH_POLICY ""
+
+// counters of each server (sent, bytes, failed, suppressed, queued, loop time) and of each variable (last sent, count),
+// last value read and filtered value of each filtered variable (VARIABLE_FILTER_LIST),
+// sent every SYNC_DIAGNOSTICS_MS_PERIOD through the first server able to (MQTT_DIAGNOSTICS_TOPIC), or printed on the debug serial
+//#define USE_SYNC_DIAGNOSTICS
+#ifdef USE_SYNC_DIAGNOSTICS
+  #define SYNC_DIAGNOSTICS_MS_PERIOD 60000L
+#endif
+
+// updates sent to each server: burst and updates per second (not defined: no limit), over the limit the updates wait,
+// lowest priority first (settings, stats, realtime, switches/status)
+//#define SYNC_RATE_LIMIT_BURST 30
+//#define SYNC_RATE_LIMIT_PER_SECOND 10
+
+// scale the publish interval of each numeric realtime variable with a publish policy (VARIABLE_PUBLISH_POLICY_LIST, PUBLISH_POLICY)
+// with its rate of change: about the time needed to move by its deadband (SYNC_ADAPTIVE_DEFAULT_STEP_PERCENT of the value if none),
+// between SYNC_ADAPTIVE_MIN_MS and SYNC_ADAPTIVE_MAX_MS.
+// The realtime sync runs every SYNC_ADAPTIVE_MIN_MS (if lower than SYNC_REALTIME_MS_PERIOD)
+//#define USE_SYNC_ADAPTIVE_CADENCE
+#ifdef USE_SYNC_ADAPTIVE_CADENCE
+  #define SYNC_ADAPTIVE_MIN_MS 1000L
+  #define SYNC_ADAPTIVE_MAX_MS 30000L
+  // smoothing of the rate of change (ms): faster oscillations cancel out, trends and steps do not
+  #define SYNC_ADAPTIVE_SMOOTHING_MS 4000L
+  #define SYNC_ADAPTIVE_DEFAULT_STEP_PERCENT 1.0f
+#endif
+
+// publish the realtime changes as soon as a register block is read from the controller (no wait for SYNC_REALTIME_MS_PERIOD),
+// for each server syncs are limited by a min interval and a token bucket
+//#define USE_SYNC_ON_CHANGE
+#ifdef USE_SYNC_ON_CHANGE
+  // min ms between 2 syncs on change
+  #define SYNC_ON_CHANGE_MIN_INTERVAL_MS 200L
+  // syncs on change allowed in a burst, a new one is allowed every SYNC_ON_CHANGE_REFILL_MS
+  #define SYNC_ON_CHANGE_BURST 5
+  #define SYNC_ON_CHANGE_REFILL_MS 1000L
+#endif
+
 
 
 
@@ -243,6 +311,8 @@
     #define BLYNK_TEMPLATE_ID "-template-id-"
     // device name
     #define BLYNK_DEVICE_NAME "SolarTracer"
+    // event code (defined in the template) for the alarms raised by the rules (USE_VARIABLE_RULES)
+    #define BLYNK_ALARM_EVENT "rule_alarm"
   #endif
 
   // Blynk API key
@@ -311,6 +381,19 @@
   #define vPIN_STAT_ENERGY_CONSUMED_THIS_MONTH            54
   #define vPIN_STAT_ENERGY_CONSUMED_THIS_YEAR             55
   #define vPIN_STAT_ENERGY_CONSUMED_TOTAL                 56
+  #define vPIN_PV_RATED_POWER                             57
+  #define vPIN_CHARGING_EFFICIENCY                        58
+  #define vPIN_BATTERY_NET_POWER                          59
+  #define vPIN_LOAD_SHARE                                 60
+  #define vPIN_PV_UTILISATION                             61
+  #define vPIN_PV_POWER_MINUTE_AVG                        62
+  #define vPIN_PV_POWER_HOUR_MAX                          63
+  #define vPIN_PV_ENERGY_HOUR                             64
+  #define vPIN_LOAD_ENERGY_HOUR                           65
+  #define vPIN_BATTERY_VOLTAGE_DAY_MIN                    66
+  #define vPIN_BATTERY_VOLTAGE_DAY_MAX                    67
+  #define vPIN_PV_ENERGY_DAY                              68
+  #define vPIN_LOAD_ENERGY_DAY                            69
   // internal
   #define vPIN_INTERNAL_STATUS                            27
   #define vPIN_INTERNAL_DEBUG_TERMINAL                    44
@@ -342,22 +425,55 @@
   #define MQTT_PASSWORD "solar123"
   // client id
   #define MQTT_CLIENT_ID "solarTracer1"
+  // min ms between 2 polls of the broker connection
+  #define MQTT_LOOP_MS_PERIOD 10
+  // diagnostics of each server (USE_SYNC_DIAGNOSTICS) are published on this topic + server name
+  #define MQTT_DIAGNOSTICS_TOPIC "solarTracer/diagnostics/"
+  // alarms raised by the rules (USE_VARIABLE_RULES) are published on this topic
+  #define MQTT_ALARM_TOPIC "solarTracer/alarm"
 
   //#define USE_MQTT_HOME_ASSISTANT
   #ifdef USE_MQTT_HOME_ASSISTANT
     #define MQTT_HOME_ASSISTANT_DEVICE_NAME "SolarTracer1"
     #define MQTT_HOME_ASSISTANT_DEVICE_ID ""
+
+    // publish the raw topics too (see MQTT_RAW_TOPIC_ROOT), home assistant and raw messages share a single broker connection
+    //#define USE_MQTT_HOME_ASSISTANT_RAW_TOPICS
+    #ifdef USE_MQTT_HOME_ASSISTANT_RAW_TOPICS
+      #define MQTT_RAW_TOPIC_ROOT "solarTracer/values/"
+    #endif
   #endif
 
   // all the "variable topics" will be published in JSON on a single topic defined in MQTT_JSON_PUBLISH_TOPIC
   //#define USE_MQTT_JSON_PUBLISH
-  #if defined(USE_MQTT_JSON_PUBLISH) && ! defined(USE_MQTT_HOME_ASSISTANT)
+  #if defined(USE_MQTT_JSON_PUBLISH) && (! defined(USE_MQTT_HOME_ASSISTANT) || defined(USE_MQTT_HOME_ASSISTANT_RAW_TOPICS))
     #define MQTT_JSON_PUBLISH_TOPIC "v1/devices/me/telemetry"
   #endif
   
+  // values that cannot be published while the broker is not reachable are queued (RAM, then LittleFS)
+  // and published again on reconnect, in batches on MQTT_OUTBOX_REPLAY_TOPIC with their timestamp
+  //#define USE_SYNC_OUTBOX
+  #if defined(USE_SYNC_OUTBOX) && (! defined(USE_MQTT_HOME_ASSISTANT) || defined(USE_MQTT_HOME_ASSISTANT_RAW_TOPICS))
+    #define MQTT_OUTBOX_REPLAY_TOPIC "solarTracer/replay"
+    // records in each replay message, min ms between 2 replay messages
+    #define MQTT_OUTBOX_REPLAY_BATCH 8
+    #define MQTT_OUTBOX_REPLAY_MS_PERIOD 250L
+  #endif
+
+  // history of a variable (USE_VARIABLE_HISTORY) on request: publish the variable topic without root and optionally
+  // the seconds to go back (eg: "pv_power 3600") on the values root + MQTT_HISTORY_REQUEST_TOPIC,
+  // the samples are published in batches on MQTT_HISTORY_TOPIC, in the replay format
+  #if defined(USE_VARIABLE_HISTORY) && (! defined(USE_MQTT_HOME_ASSISTANT) || defined(USE_MQTT_HOME_ASSISTANT_RAW_TOPICS))
+    #define MQTT_HISTORY_REQUEST_TOPIC "history_request"
+    #define MQTT_HISTORY_TOPIC "solarTracer/history"
+    // samples in each message, min ms between 2 messages
+    #define MQTT_HISTORY_BATCH 8
+    #define MQTT_HISTORY_MS_PERIOD 250L
+  #endif
+
   // use rpc to send control messages to this board (early stage support)
   //#define USE_MQTT_RPC_SUBSCRIBE
-  #if defined(USE_MQTT_RPC_SUBSCRIBE) && ! defined(USE_MQTT_HOME_ASSISTANT)
+  #if defined(USE_MQTT_RPC_SUBSCRIBE) && (! defined(USE_MQTT_HOME_ASSISTANT) || defined(USE_MQTT_HOME_ASSISTANT_RAW_TOPICS))
     #define MQTT_RPC_SUBSCRIBE_TOPIC "v1/devices/me/rpc/request/+"
   #endif
 
@@ -418,6 +534,19 @@
   #define MQTT_TOPIC_BATTERY_BOOST_DURATION                   MQTT_TOPIC_ROOT "battery_settings_boost_duration"
   #define MQTT_TOPIC_BATTERY_TEMPERATURE_COMPENSATION_COEFF   MQTT_TOPIC_ROOT "battery_settings_temperature_compensation_coeff"
   #define MQTT_TOPIC_BATTERY_MANAGEMENT_MODE                  MQTT_TOPIC_ROOT "battery_settings_management_mode"
+  #define MQTT_TOPIC_PV_RATED_POWER                           MQTT_TOPIC_ROOT "pv_rated_power"
+  #define MQTT_TOPIC_CHARGING_EFFICIENCY                      MQTT_TOPIC_ROOT "battery_charging_efficiency"
+  #define MQTT_TOPIC_BATTERY_NET_POWER                        MQTT_TOPIC_ROOT "battery_net_power"
+  #define MQTT_TOPIC_LOAD_SHARE                               MQTT_TOPIC_ROOT "load_share"
+  #define MQTT_TOPIC_PV_UTILISATION                           MQTT_TOPIC_ROOT "pv_utilisation"
+  #define MQTT_TOPIC_PV_POWER_MINUTE_AVG                      MQTT_TOPIC_ROOT "pv_power_last_minute_avg"
+  #define MQTT_TOPIC_PV_POWER_HOUR_MAX                        MQTT_TOPIC_ROOT "pv_power_last_hour_max"
+  #define MQTT_TOPIC_PV_ENERGY_HOUR                           MQTT_TOPIC_ROOT "pv_energy_last_hour"
+  #define MQTT_TOPIC_LOAD_ENERGY_HOUR                         MQTT_TOPIC_ROOT "load_energy_last_hour"
+  #define MQTT_TOPIC_BATTERY_VOLTAGE_DAY_MIN                  MQTT_TOPIC_ROOT "battery_voltage_last_day_min"
+  #define MQTT_TOPIC_BATTERY_VOLTAGE_DAY_MAX                  MQTT_TOPIC_ROOT "battery_voltage_last_day_max"
+  #define MQTT_TOPIC_PV_ENERGY_DAY                            MQTT_TOPIC_ROOT "pv_energy_last_day"
+  #define MQTT_TOPIC_LOAD_ENERGY_DAY                          MQTT_TOPIC_ROOT "load_energy_last_day"
   // internal
   #define MQTT_TOPIC_INTERNAL_STATUS                          MQTT_TOPIC_ROOT "internal_status"
   //action
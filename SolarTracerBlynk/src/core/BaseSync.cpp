@@ -22,24 +22,18 @@
 #include "BaseSync.h"
 
 #include "../core/Controller.h"
+#include "../core/Util.h"
 #include "../core/VariableDefiner.h"
 #include "../core/debug.h"
 
-#define VALUE_CACHES_UNTIL_COUNT 100;
+SyncChangeSet BaseSync::changeSets[2] = {};
+#ifdef USE_SYNC_ADAPTIVE_CADENCE
+float BaseSync::changeRate[Variable::VARIABLES_COUNT] = {};
+float BaseSync::sampleValue[Variable::VARIABLES_COUNT] = {};
+uint32_t BaseSync::sampleMillis[Variable::VARIABLES_COUNT] = {};
+#endif
 
 BaseSync::BaseSync() {
-    this->renewValuesCount = new uint8_t[Variable::VARIABLES_COUNT]();
-    this->lastValuesCache = new void *[Variable::VARIABLES_COUNT]();
-
-    uint8_t varSize;
-    for (uint8_t index = 0; index < Variable::VARIABLES_COUNT; index++) {
-        this->renewValuesCount[index] = 0;
-        varSize = VariableDefiner::getInstance().getVariableSize((Variable)index);
-        if (varSize > 0) {
-            this->lastValuesCache[index] = malloc(varSize);
-            memset(this->lastValuesCache[index], 0, varSize);
-        }
-    }
 }
 
 void BaseSync::applyUpdateToVariable(Variable variable, const void *value, bool silent) {
@@ -67,20 +61,145 @@ void BaseSync::applyUpdateToVariable(Variable variable, const void *value, bool
     }
 }
 
+const SyncChangeSet *BaseSync::getChangeSet(VariableSource source) {
+    SolarTracer *solarT = Controller::getInstance().getSolarController();
+    SyncChangeSet *changeSet = &(BaseSync::changeSets[source == VariableSource::SR_STATS ? 1 : 0]);
+    uint16_t generation = solarT->getChangeGeneration(source);
+    if (changeSet->initialized && changeSet->toGeneration == generation) {
+        return changeSet;
+    }
+
+    memset(changeSet->changed, 0, BASE_SYNC_BITSET_SIZE);
+    memset(changeSet->enabled, 0, BASE_SYNC_BITSET_SIZE);
+    memset(changeSet->ready, 0, BASE_SYNC_BITSET_SIZE);
+    changeSet->allChanged = !changeSet->initialized || !solarT->isChangeLogAvailable(source, changeSet->toGeneration);
+    changeSet->fromGeneration = changeSet->toGeneration;
+    if (!changeSet->allChanged) {
+        uint16_t cursor = changeSet->toGeneration;
+        Variable variable;
+        while (solarT->nextChangedVariable(source, cursor, variable)) {
+            BaseSync::setBit(changeSet->changed, variable);
+        }
+    }
+    for (uint8_t index = 0; index < Variable::VARIABLES_COUNT; index++) {
+        const VariableDefinition *def = VariableDefiner::getInstance().getDefinition((Variable)index);
+        if (def->source != source) {
+            continue;
+        }
+        if (changeSet->allChanged) {
+            BaseSync::setBit(changeSet->changed, index);
+        }
+        if (solarT->isVariableEnabled((Variable)index) || solarT->isVariableOverWritten((Variable)index)) {
+            BaseSync::setBit(changeSet->enabled, index);
+        }
+        if (solarT->isVariableReadReady((Variable)index)) {
+            BaseSync::setBit(changeSet->ready, index);
+        }
+    }
+    changeSet->toGeneration = generation;
+    changeSet->initialized = true;
+
+    return changeSet;
+}
+
 uint8_t BaseSync::sendUpdateAllBySource(VariableSource allowedSource, bool silent) {
     SolarTracer *solarT = Controller::getInstance().getSolarController();
+    const SyncChangeSet *changeSet = BaseSync::getChangeSet(allowedSource);
+    uint8_t sourceIndex = allowedSource == VariableSource::SR_STATS ? 1 : 0;
+    uint16_t *cursor = &(this->generationCursor[sourceIndex]);
     uint8_t varNotReady = 0;
     const VariableDefinition *def;
+    const void *value = nullptr;
+
+    // rounds missed by this backend (ie. synced out of the timer) and no longer in the change log
+    bool roundsLost = !changeSet->allChanged && *cursor != changeSet->fromGeneration && *cursor != changeSet->toGeneration && !solarT->isChangeLogAvailable(allowedSource, *cursor);
+    bool fullSync = this->fullSyncRequired[sourceIndex] || roundsLost;
+    uint32_t now = millis();
+
+    if (fullSync) {
+        for (uint8_t index = 0; index < Variable::VARIABLES_COUNT; index++) {
+            if (VariableDefiner::getInstance().getDefinition((Variable)index)->source == allowedSource) {
+                this->setPending(index, true);
+            }
+        }
+        this->fullSyncRequired[sourceIndex] = false;
+        *cursor = changeSet->toGeneration;
+    } else {
+        this->mergeChangeSet(allowedSource, changeSet);
+    }
+
+    if (!fullSync && !this->queueing && (int32_t)(now - this->nextHeartbeatMillis[sourceIndex]) >= 0) {
+        this->nextHeartbeatMillis[sourceIndex] = this->setHeartbeatPending(allowedSource, changeSet, now);
+    }
 
     for (uint8_t index = 0; index < Variable::VARIABLES_COUNT; index++) {
+        if (this->pendingVariables[index >> 3] == 0) {
+            // nothing pending in this group of 8
+            index |= 7;
+            continue;
+        }
+        if (!this->isPending(index)) {
+            continue;
+        }
         def = VariableDefiner::getInstance().getDefinition((Variable)index);
-        if (def->source == allowedSource && this->isVariableAllowed(def) && (solarT->isVariableEnabled(def->variable) || solarT->isVariableOverWritten(def->variable))) {
-            if (!solarT->isVariableReadReady(def->variable) || !this->syncVariable(def, solarT->getValue(def->variable))) {
+        bool throttled = BaseSync::isBitSet(this->throttledVariables, index);
+        bool enabled;
+        bool ready;
+        if (def->source == allowedSource) {
+            enabled = BaseSync::isBitSet(changeSet->enabled, index);
+            ready = BaseSync::isBitSet(changeSet->ready, index);
+        } else if (throttled) {
+            // deferred by the rate limit, not waiting for the next round of its source
+            enabled = solarT->isVariableEnabled(def->variable) || solarT->isVariableOverWritten(def->variable);
+            ready = solarT->isVariableReadReady(def->variable);
+        } else {
+            continue;
+        }
+        this->setThrottled(index, false);
+        if (!this->isVariableAllowed(def) || !enabled) {
+            this->setPending(index, false);
+            continue;
+        }
+        if (ready) {
+            value = solarT->getValue(def->variable);
+            // full syncs and heartbeats are sent anyway
+            uint32_t heartbeatAge = this->getHeartbeatAge(def->variable);
+            bool heartbeat = heartbeatAge > 0 && !this->queueing && this->lastSentMillis[index] > 0 && now - this->lastSentMillis[index] >= heartbeatAge;
+            switch (fullSync || heartbeat ? BASE_SYNC_PUBLISH_NOW : this->checkPublishPolicy(def, value)) {
+                case BASE_SYNC_PUBLISH_DROP:
+                    this->setPending(index, false);
+                    this->metrics.suppressed++;
+                    continue;
+                case BASE_SYNC_PUBLISH_LATER:
+                    this->metrics.delayed++;
+                    continue;
+            }
+            VariableSyncPriority priority = VariableDefiner::getInstance().getSyncPriority(def->variable);
+            // a deferred update moves up one priority, so that it is not starved by the updates of its own class
+            if (!this->takeSendToken(throttled && priority > 0 ? (VariableSyncPriority)(priority - 1) : priority, now)) {
+                // still pending: sent with its latest value when the budget allows
+                this->setThrottled(index, true);
+                if (!throttled) {
+                    this->throttledCount[priority]++;
+                }
+                continue;
+            }
+        }
+        if (ready && this->sendUpdateToVariable(def, value)) {
+            this->setPending(index, false);
+            this->lastSentValue[index] = BaseSync::getNumericValue(def, value);
+            this->lastSentMillis[index] = now;
+            if (!this->queueing) {
+                this->sendCount[index]++;
+                this->metrics.sent++;
+                this->metrics.bytes += BaseSync::getValueTextLength(def, value);
+            }
+        } else {
+            ready ? this->metrics.failed++ : this->metrics.notReady++;
 #ifdef USE_DEBUG_SERIAL_VERBOSE_SYNC_ERROR_VARIABLE
-                debugPrintf(true, Text::syncErrorWithVariable, def->text);
+            debugPrintf(true, Text::syncErrorWithVariable, def->text);
 #endif
-                varNotReady++;
-            }
+            varNotReady++;
         }
     }
 
@@ -92,21 +211,231 @@ uint8_t BaseSync::sendUpdateAllBySource(VariableSource allowedSource, bool silen
     return varNotReady;
 }
 
-bool BaseSync::syncVariable(const VariableDefinition *def, const void *value) {
-    uint8_t *cachedUntil = &(this->renewValuesCount[def->variable]);
-    if (this->isVariableAllowed(def)) {
-        if (!(
-                this->renewValueCount == 1 || (*cachedUntil) <= 0                                                            // sync always enabled?
-                || !VariableDefiner::getInstance().isValueEqual(def->variable, value, this->lastValuesCache[def->variable])  // value has changed?
-                || (this->renewValueCount > 1 && ((*cachedUntil)--) <= 0)                                                    // renew required?
-                )                                                                                                            // -> should sync evaluation?
-            || this->sendUpdateToVariable(def, value)) {
-            memcpy(this->lastValuesCache[def->variable], value, VariableDefiner::getInstance().getVariableSize(def->variable));
-            if (this->renewValueCount > 1 || (*cachedUntil) <= 0) {
-                (*cachedUntil) = this->renewValueCount + 1;
-            }
-            return true;
+void BaseSync::mergeChangeSet(VariableSource source, const SyncChangeSet *changeSet) {
+    uint16_t *cursor = &(this->generationCursor[source == VariableSource::SR_STATS ? 1 : 0]);
+    if (*cursor == changeSet->toGeneration) {
+        // already consumed: an "all changed" set must not be merged again
+        return;
+    }
+    if (changeSet->allChanged || *cursor == changeSet->fromGeneration) {
+        for (uint8_t index = 0; index < BASE_SYNC_BITSET_SIZE; index++) {
+            this->pendingVariables[index] |= changeSet->changed[index];
+        }
+    } else {
+        // rounds missed by this backend, still in the change log
+        Variable variable;
+        while (Controller::getInstance().getSolarController()->nextChangedVariable(source, *cursor, variable)) {
+            this->setPending(variable, true);
+        }
+    }
+    *cursor = changeSet->toGeneration;
+}
+
+bool BaseSync::takeSendToken(VariableSyncPriority priority, uint32_t now) {
+    if (this->rateLimitPerSecond == 0) {
+        return true;
+    }
+    uint32_t elapsed = now - this->sendTokensRefillMillis;
+    if (this->sendTokens < this->rateLimitBurst && elapsed < (uint32_t)this->rateLimitBurst * 1000 / this->rateLimitPerSecond) {
+        // elapsed is below the time to fill the bucket: no overflow
+        uint32_t refilled = elapsed * this->rateLimitPerSecond / 1000;
+        if (refilled > 0) {
+            this->sendTokens = refilled >= (uint32_t)(this->rateLimitBurst - this->sendTokens) ? this->rateLimitBurst : this->sendTokens + refilled;
+            this->sendTokensRefillMillis += refilled * 1000 / this->rateLimitPerSecond;
+        }
+    } else {
+        // full, or filled since the last update (the burst can be changed by the sync)
+        this->sendTokens = this->rateLimitBurst;
+        this->sendTokensRefillMillis = now;
+    }
+    // lower priorities leave a share of the bucket to the higher ones
+    if (this->sendTokens == 0 || this->sendTokens <= (uint16_t)this->rateLimitBurst * priority / VariableSyncPriority::SP_COUNT) {
+        return false;
+    }
+    this->sendTokens--;
+    return true;
+}
+
+uint8_t BaseSync::getPendingCount() {
+    uint8_t count = 0;
+    for (uint8_t index = 0; index < BASE_SYNC_BITSET_SIZE; index++) {
+        for (uint8_t bits = this->pendingVariables[index]; bits > 0; bits &= bits - 1) {
+            count++;
+        }
+    }
+    return count;
+}
+
+uint16_t BaseSync::getValueTextLength(const VariableDefinition *def, const void *value) {
+    switch (def->datatype) {
+        case VariableDatatype::DT_BOOL:
+            return 1;
+        case VariableDatatype::DT_UINT16:
+            return Util::digits(*(const uint16_t *)value);
+        case VariableDatatype::DT_FLOAT:
+            // sign, 4 decimals
+            return (*(const float *)value < 0 ? 6 : 5) + Util::digits((int)*(const float *)value);
+        case VariableDatatype::DT_STRING:
+            return strlen((const char *)value);
+    }
+    return 0;
+}
+
+uint16_t BaseSync::getThrottledCount(VariableSyncPriority priority) {
+    return this->throttledCount[priority];
+}
+
+uint32_t BaseSync::getHeartbeatAge(Variable variable) {
+    if (this->maxAge == 0) {
+        return 0;
+    }
+    uint16_t variableMaxAge = VariableDefiner::getInstance().getPublishPolicy(variable)->maxAge;
+    uint32_t age = variableMaxAge > 0 ? variableMaxAge * 1000UL : this->maxAge;
+    // (variable * 157) & 0xFF spreads the variables over 0 - 255
+    return age - (age >> 10) * ((variable * 157) & 0xFF);
+}
+
+uint32_t BaseSync::setHeartbeatPending(VariableSource source, const SyncChangeSet *changeSet, uint32_t now) {
+    // variables sent for the first time are checked within a max age
+    uint32_t nextHeartbeat = now + this->maxAge;
+    for (uint8_t index = 0; index < Variable::VARIABLES_COUNT; index++) {
+        if (VariableDefiner::getInstance().getDefinition((Variable)index)->source != source || !BaseSync::isBitSet(changeSet->enabled, index) || this->lastSentMillis[index] == 0) {
+            continue;
+        }
+        uint32_t heartbeatAge = this->getHeartbeatAge((Variable)index);
+        if (heartbeatAge == 0) {
+            continue;
+        }
+        if (now - this->lastSentMillis[index] >= heartbeatAge) {
+            this->setPending(index, true);
+            // checked again after a full max age if not sent
+            heartbeatAge += now - this->lastSentMillis[index];
+        }
+        if ((int32_t)(this->lastSentMillis[index] + heartbeatAge - nextHeartbeat) < 0) {
+            nextHeartbeat = this->lastSentMillis[index] + heartbeatAge;
+        }
+    }
+    return nextHeartbeat;
+}
+
+#ifdef USE_SYNC_ON_CHANGE
+bool BaseSync::isSyncOnChangeAllowed(VariableSource source) {
+    if (this->generationCursor[source == VariableSource::SR_STATS ? 1 : 0] == Controller::getInstance().getSolarController()->getChangeGeneration(source)) {
+        // nothing new
+        return false;
+    }
+    uint32_t now = millis();
+    if (this->syncOnChangeTokens < this->syncOnChangeBurst) {
+        uint32_t refilled = (now - this->syncOnChangeRefillMillis) / this->syncOnChangeRefill;
+        if (refilled > 0) {
+            this->syncOnChangeTokens = refilled >= (uint32_t)(this->syncOnChangeBurst - this->syncOnChangeTokens) ? this->syncOnChangeBurst : this->syncOnChangeTokens + refilled;
+            this->syncOnChangeRefillMillis += refilled * this->syncOnChangeRefill;
+        }
+    } else {
+        this->syncOnChangeRefillMillis = now;
+    }
+    if (this->syncOnChangeTokens == 0 || (this->lastSyncOnChangeMillis > 0 && now - this->lastSyncOnChangeMillis < this->syncOnChangeMinInterval)) {
+        return false;
+    }
+    this->syncOnChangeTokens--;
+    this->lastSyncOnChangeMillis = now;
+    return true;
+}
+#endif
+
+uint8_t BaseSync::checkPublishPolicy(const VariableDefinition *def, const void *value) {
+    const VariablePublishPolicy *policy = VariableDefiner::getInstance().getPublishPolicy(def->variable);
+    if (policy->deadbandType != VariableDeadbandType::DB_NONE && this->lastSentMillis[def->variable] > 0 &&
+        VariableDefiner::getInstance().isWithinDeadband(def->variable, this->lastSentValue[def->variable], BaseSync::getNumericValue(def, value))) {
+        return BASE_SYNC_PUBLISH_DROP;
+    }
+    if (policy->minInterval > 0 && this->lastSentMillis[def->variable] > 0 && millis() - this->lastSentMillis[def->variable] < policy->minInterval * 1000UL) {
+        return BASE_SYNC_PUBLISH_LATER;
+    }
+#ifdef USE_SYNC_ADAPTIVE_CADENCE
+    if (this->lastSentMillis[def->variable] > 0 && millis() - this->lastSentMillis[def->variable] < BaseSync::getAdaptiveInterval(def)) {
+        return BASE_SYNC_PUBLISH_LATER;
+    }
+#endif
+    return BASE_SYNC_PUBLISH_NOW;
+}
+
+#ifdef USE_SYNC_ADAPTIVE_CADENCE
+void BaseSync::sampleChangeRates() {
+    SolarTracer *solarT = Controller::getInstance().getSolarController();
+    uint32_t now = millis();
+    for (uint8_t index = 0; index < Variable::VARIABLES_COUNT; index++) {
+        const VariableDefinition *def = VariableDefiner::getInstance().getDefinition((Variable)index);
+        if (!BaseSync::isAdaptive(def)) {
+            continue;
+        }
+        if (!solarT->isVariableReadReady(def->variable)) {
+            // the next value restarts the sampling
+            BaseSync::sampleMillis[index] = 0;
+            continue;
         }
+        // first sample: no rate yet
+        uint32_t elapsed = BaseSync::sampleMillis[index] > 0 ? now - BaseSync::sampleMillis[index] : 0;
+        // unchanged values are sampled too, so the rate goes back down when the value stops moving
+        BaseSync::updateChangeRate(def->variable, BaseSync::getNumericValue(def, solarT->getValue(def->variable)), elapsed);
+        BaseSync::sampleMillis[index] = now > 0 ? now : 1;
+    }
+}
+
+bool BaseSync::isAdaptive(const VariableDefinition *def) {
+    if (def->source != VariableSource::SR_REALTIME || (def->datatype != VariableDatatype::DT_FLOAT && def->datatype != VariableDatatype::DT_UINT16)) {
+        return false;
     }
-    return false;
-}
\ No newline at end of file
+    // variables without a publish policy are sent on every change
+    const VariablePublishPolicy *policy = VariableDefiner::getInstance().getPublishPolicy(def->variable);
+    return policy->deadbandType != VariableDeadbandType::DB_NONE || policy->minInterval > 0 || policy->maxAge > 0;
+}
+
+void BaseSync::updateChangeRate(Variable variable, float value, uint32_t elapsed) {
+    if (elapsed > 0) {
+        float rate = (value - BaseSync::sampleValue[variable]) * 1000 / elapsed;
+        // exponential moving average, weighted by the time elapsed
+        BaseSync::changeRate[variable] += (rate - BaseSync::changeRate[variable]) * elapsed / (SYNC_ADAPTIVE_SMOOTHING_MS + elapsed);
+    }
+    BaseSync::sampleValue[variable] = value;
+}
+
+uint32_t BaseSync::getAdaptiveInterval(const VariableDefinition *def) {
+    if (!BaseSync::isAdaptive(def)) {
+        return 0;
+    }
+    const VariablePublishPolicy *policy = VariableDefiner::getInstance().getPublishPolicy(def->variable);
+    float value = BaseSync::sampleValue[def->variable] > 0 ? BaseSync::sampleValue[def->variable] : -BaseSync::sampleValue[def->variable];
+    // change worth a publish
+    float step;
+    switch (policy->deadbandType) {
+        case VariableDeadbandType::DB_ABSOLUTE:
+            step = policy->deadband;
+            break;
+        case VariableDeadbandType::DB_PERCENT:
+            step = value * policy->deadband / 100;
+            break;
+        default:
+            step = value * SYNC_ADAPTIVE_DEFAULT_STEP_PERCENT / 100;
+    }
+    float rate = BaseSync::changeRate[def->variable] > 0 ? BaseSync::changeRate[def->variable] : -BaseSync::changeRate[def->variable];
+    if (rate <= 0 || step / rate * 1000 >= SYNC_ADAPTIVE_MAX_MS) {
+        return SYNC_ADAPTIVE_MAX_MS;
+    }
+    uint32_t interval = step / rate * 1000;
+    return interval > SYNC_ADAPTIVE_MIN_MS ? interval : SYNC_ADAPTIVE_MIN_MS;
+}
+#endif
+
+float BaseSync::getNumericValue(const VariableDefinition *def, const void *value) {
+    switch (def->datatype) {
+        case VariableDatatype::DT_FLOAT:
+            return *(const float *)value;
+        case VariableDatatype::DT_UINT16:
+            return *(const uint16_t *)value;
+        case VariableDatatype::DT_BOOL:
+            return *(const bool *)value ? 1 : 0;
+        default:
+            return 0;
+    }
+}
@@ -26,7 +26,58 @@
 
 #include "../core/VariableDefiner.h"
 
-#define BASE_SYNC_RENEW_VALUE_COUNT 20;
+// ms after which an unchanged value is sent again
+#define BASE_SYNC_MAX_AGE_MS 40000L
+
+// outcome of the publish policy check
+#define BASE_SYNC_PUBLISH_NOW 0
+#define BASE_SYNC_PUBLISH_DROP 1
+#define BASE_SYNC_PUBLISH_LATER 2
+
+#define BASE_SYNC_BITSET_SIZE ((Variable::VARIABLES_COUNT + 7) / 8)
+
+// no rate limit unless set in config.h
+#ifndef SYNC_RATE_LIMIT_BURST
+#define SYNC_RATE_LIMIT_BURST 0
+#endif
+#ifndef SYNC_RATE_LIMIT_PER_SECOND
+#define SYNC_RATE_LIMIT_PER_SECOND 0
+#endif
+
+/**
+ * Variables of a source changed since the previous sync round, computed once and shared by all the sync backends.
+ * Values are not copied: they are read from the tracer, which is not updated while a round is running. Every change
+ * of a value or of the enabled, overwritten or ready state moves the tracer generation, so the set is rebuilt
+ * before it can differ from the tracer.
+ */
+struct SyncChangeSet {
+        // tracer change generations covered: (fromGeneration, toGeneration]
+        uint16_t fromGeneration;
+        uint16_t toGeneration;
+        // every variable of the source is in changed (first round or change log not available)
+        bool allChanged;
+        bool initialized;
+        uint8_t changed[BASE_SYNC_BITSET_SIZE];
+        // enabled or overwritten
+        uint8_t enabled[BASE_SYNC_BITSET_SIZE];
+        uint8_t ready[BASE_SYNC_BITSET_SIZE];
+};
+
+/**
+ * Counters of a sync backend since boot
+ */
+struct SyncMetrics {
+        uint32_t sent;
+        // values sent as text (payload only)
+        uint32_t bytes;
+        uint32_t failed;
+        // not read from the controller yet
+        uint32_t notReady;
+        // changes dropped by the publish policy (within the deadband of the last value sent)
+        uint32_t suppressed;
+        // changes waiting for the min interval of the publish policy (each round)
+        uint32_t delayed;
+};
 
 class BaseSync {
     public:
@@ -43,23 +94,267 @@ class BaseSync {
          */
         virtual bool sendUpdateToVariable(const VariableDefinition *def, const void *value) = 0;
         virtual bool isVariableAllowed(const VariableDefinition *def) = 0;
-        void applyUpdateToVariable(Variable variable, const void *value, bool silent = true);
+        // upload values stats
+        virtual void uploadStats() = 0;
+        // upload values realtime
+        virtual void uploadRealtime() = 0;
+
+        /**
+         * ms when loop() has to be called again (the loop has just been run at now), until then the backend is idle
+         */
+        virtual uint32_t getLoopDeadline(uint32_t now) {
+            return now + this->loopInterval;
+        }
 
-        bool syncVariable(const VariableDefinition *def, const void *value);
+        void applyUpdateToVariable(Variable variable, const void *value, bool silent = true);
 
+        /**
+         * Send the variables of the source changed since the last call (and the ones failed before)
+         *
+         * @return number of variables not synced
+         */
         uint8_t sendUpdateAllBySource(VariableSource allowedSource, bool silent = true);
 
+        /**
+         * Change set of the current round, rebuilt only when the tracer has new changes of the source
+         */
+        static const SyncChangeSet *getChangeSet(VariableSource source);
+
+        /**
+         * Updates deferred by the rate limit, for each priority
+         */
+        uint16_t getThrottledCount(VariableSyncPriority priority);
+
+        inline const SyncMetrics *getMetrics() {
+            return &(this->metrics);
+        }
+
+        /**
+         * Variables waiting to be sent (changed, throttled, delayed or failed)
+         */
+        uint8_t getPendingCount();
+
+        /**
+         * Values queued by the backend while the server is not reachable
+         */
+        virtual uint16_t getQueuedCount() {
+            return 0;
+        }
+
+        /**
+         * Values dropped from the queue of the backend (full)
+         */
+        virtual uint16_t getDroppedCount() {
+            return 0;
+        }
+
+        /**
+         * When the variable has been sent (ms, 0 if never) and how many times
+         */
+        inline uint32_t getLastSentMillis(Variable variable) {
+            return this->lastSentMillis[variable];
+        }
+
+        inline uint16_t getSendCount(Variable variable) {
+            return this->sendCount[variable];
+        }
+
+#ifdef USE_SYNC_DIAGNOSTICS
+        /**
+         * Publish the diagnostics of a backend (JSON) on the diagnostics endpoint of this backend, if any
+         */
+        virtual bool sendDiagnostics(const char *name, const char *json) {
+            return false;
+        }
+#endif
+
+#ifdef USE_VARIABLE_RULES
+        /**
+         * Notify an alarm raised by a rule on the alarm endpoint of this backend, if any
+         */
+        virtual bool sendAlarm(const char *message) {
+            return false;
+        }
+#endif
+
+#ifdef USE_SYNC_ON_CHANGE
+        /**
+         * Check if the tracer has new changes of the source and a sync on change is allowed now (a token is taken)
+         */
+        bool isSyncOnChangeAllowed(VariableSource source);
+#endif
+
+#ifdef USE_SYNC_ADAPTIVE_CADENCE
+        /**
+         * Update the rate of change of the adaptive variables, to be called after each tracer update
+         */
+        static void sampleChangeRates();
+#endif
+
     protected:
         /**
-         *  0   sync on change only
-         *  1   sync always
-         *  ..  use renew count
+         * min ms between 2 calls of loop() (0: every main loop)
+         */
+        uint16_t loopInterval = 0;
+
+        /**
+         * ms after which an unchanged value is sent again, overridden by VariablePublishPolicy::maxAge (0: sync on change only)
+         */
+        uint32_t maxAge = BASE_SYNC_MAX_AGE_MS;
+
+        /**
+         * Set while sendUpdateToVariable() queues the values (server not reachable): no heartbeats and the values
+         * queued are not counted as sent
+         */
+        bool queueing = false;
+
+        /**
+         * Rate limit of the updates sent: token bucket size and tokens given back per second (0: no limit)
          */
-        uint8_t renewValueCount = BASE_SYNC_RENEW_VALUE_COUNT;
+        uint8_t rateLimitBurst = SYNC_RATE_LIMIT_BURST;
+        uint8_t rateLimitPerSecond = SYNC_RATE_LIMIT_PER_SECOND;
+
+#ifdef USE_SYNC_ON_CHANGE
+        /**
+         * Limits of the syncs on change: min ms between 2 syncs, token bucket size and ms to get a token back
+         */
+        uint16_t syncOnChangeMinInterval = SYNC_ON_CHANGE_MIN_INTERVAL_MS;
+        uint8_t syncOnChangeBurst = SYNC_ON_CHANGE_BURST;
+        uint16_t syncOnChangeRefill = SYNC_ON_CHANGE_REFILL_MS;
+#endif
+
+        /**
+         * Value of a numeric or bool variable as float (0 for strings)
+         */
+        static float getNumericValue(const VariableDefinition *def, const void *value);
 
     private:
-        void **lastValuesCache;
+        /**
+         * Last generation of the tracer change log consumed (realtime, stats)
+         */
+        uint16_t generationCursor[2] = {};
+
+        /**
+         * Mark as pending the variables changed since the cursor of this backend, then move the cursor to the change set
+         */
+        void mergeChangeSet(VariableSource source, const SyncChangeSet *changeSet);
+
+        bool fullSyncRequired[2] = {true, true};
+
+        /**
+         * When the next unchanged value has to be sent again (ms, realtime, stats)
+         */
+        uint32_t nextHeartbeatMillis[2] = {};
+
+        uint8_t sendTokens = SYNC_RATE_LIMIT_BURST;
+        uint32_t sendTokensRefillMillis = 0;
+        uint16_t throttledCount[VariableSyncPriority::SP_COUNT] = {};
+
+        SyncMetrics metrics = {};
+        uint16_t sendCount[Variable::VARIABLES_COUNT] = {};
+
+        /**
+         * Length of the value as text, as most of the backends send it
+         */
+        static uint16_t getValueTextLength(const VariableDefinition *def, const void *value);
+
+        /**
+         * Bitset of the pending variables deferred by the rate limit
+         */
+        uint8_t throttledVariables[BASE_SYNC_BITSET_SIZE] = {};
+
+        /**
+         * Take a token of the rate limit, the bucket can be emptied by the highest priority only
+         */
+        bool takeSendToken(VariableSyncPriority priority, uint32_t now);
+
+#ifdef USE_SYNC_ON_CHANGE
+        uint8_t syncOnChangeTokens = SYNC_ON_CHANGE_BURST;
+        uint32_t syncOnChangeRefillMillis = 0;
+        uint32_t lastSyncOnChangeMillis = 0;
+#endif
+
+        /**
+         * Last numeric value sent (or queued) of each variable and when (ms), see VariablePublishPolicy
+         */
+        float lastSentValue[Variable::VARIABLES_COUNT] = {};
+        uint32_t lastSentMillis[Variable::VARIABLES_COUNT] = {};
+
+        /**
+         * Check the publish policy of a changed variable: drop changes within the deadband, delay publishes before the min interval
+         */
+        uint8_t checkPublishPolicy(const VariableDefinition *def, const void *value);
+
+
+        /**
+         * ms after the last send when the variable has to be sent again, 0 if never.
+         * Up to 1/4 of the max age is taken off, different for each variable, so that the heartbeats do not fire all together.
+         */
+        uint32_t getHeartbeatAge(Variable variable);
+
+        /**
+         * Set pending the variables of the source to be sent again, return when the next one is due
+         */
+        uint32_t setHeartbeatPending(VariableSource source, const SyncChangeSet *changeSet, uint32_t now);
+
+        /**
+         * Bitset of the variables to be sent (changed, not ready or failed)
+         */
+        uint8_t pendingVariables[BASE_SYNC_BITSET_SIZE] = {};
+
+        /**
+         * Shared change sets (realtime, stats)
+         */
+        static SyncChangeSet changeSets[2];
+
+#ifdef USE_SYNC_ADAPTIVE_CADENCE
+        /**
+         * Smoothed rate of change of the realtime numeric variables (units per s, signed), see SYNC_ADAPTIVE_SMOOTHING_MS.
+         * Sampled after each tracer update (see sampleChangeRates), shared by all the backends.
+         */
+        static float changeRate[Variable::VARIABLES_COUNT];
+        static float sampleValue[Variable::VARIABLES_COUNT];
+        static uint32_t sampleMillis[Variable::VARIABLES_COUNT];
+
+        static void updateChangeRate(Variable variable, float value, uint32_t elapsed);
+
+        /**
+         * ms between 2 publishes of the variable for its rate of change, 0 if not adaptive
+         */
+        static uint32_t getAdaptiveInterval(const VariableDefinition *def);
+
+        /**
+         * Realtime numeric variable with a publish policy (VARIABLE_PUBLISH_POLICY_LIST or PUBLISH_POLICY)
+         */
+        static bool isAdaptive(const VariableDefinition *def);
+#endif
+
+        static inline bool isBitSet(const uint8_t *bitset, uint8_t index) {
+            return (bitset[index >> 3] & (1 << (index & 7))) > 0;
+        }
+
+        static inline void setBit(uint8_t *bitset, uint8_t index) {
+            bitset[index >> 3] |= (1 << (index & 7));
+        }
+
+        inline void setThrottled(uint8_t index, bool throttled) {
+            if (throttled) {
+                BaseSync::setBit(this->throttledVariables, index);
+            } else {
+                this->throttledVariables[index >> 3] &= ~(1 << (index & 7));
+            }
+        }
+
+        inline bool isPending(uint8_t index) {
+            return BaseSync::isBitSet(this->pendingVariables, index);
+        }
 
-        uint8_t *renewValuesCount;
+        inline void setPending(uint8_t index, bool pending) {
+            if (pending) {
+                this->pendingVariables[index >> 3] |= (1 << (index & 7));
+            } else {
+                this->pendingVariables[index >> 3] &= ~(1 << (index & 7));
+            }
+        }
 };
 #endif
\ No newline at end of file
@@ -14,6 +14,9 @@ void Environment::loadEnvData() {
     strcpy(envData.wifiDns1, WIFI_DNS1);
     strcpy(envData.wifiDns2, WIFI_DNS2);
 
+    strcpy(envData.syncDisabled, SYNC_DISABLED);
+    strcpy(envData.publishPolicy, PUBLISH_POLICY);
+
 #ifdef USE_WIFI_AP_CONFIGURATION
     strcpy(envData.wmApSSID, WIFI_AP_CONFIGURATION_HOSTNAME);
     strcpy(envData.wmApPassword, WIFI_AP_CONFIGURATION_PASSWORD);
@@ -82,6 +85,8 @@ void Environment::loadEnvData() {
                 if (doc.containsKey(CONFIG_SERIAL_DEBUG)) {
                     envData.serialDebug = doc[CONFIG_SERIAL_DEBUG];
                 }
+                loadStringToEnvIfExist(doc, CONFIG_SYNC_DISABLED, envData.syncDisabled);
+                loadStringToEnvIfExist(doc, CONFIG_PUBLISH_POLICY, envData.publishPolicy);
 
                 loadStringToEnvIfExist(doc, CONFIG_WIFI_SSID, envData.wifiSSID);
                 loadStringToEnvIfExist(doc, CONFIG_WIFI_PASSWORD, envData.wifiPassword);
@@ -30,6 +30,8 @@
 
 struct EnvironrmentData {
         bool serialDebug = false;
+        char syncDisabled[CONFIG_SYNC_DISABLED_LEN + 1];
+        char publishPolicy[CONFIG_PUBLISH_POLICY_LEN + 1];
         // wifi
         char wifiSSID[CONFIG_WIFI_SSID_LEN + 1] = WIFI_SSID;
         char wifiPassword[CONFIG_WIFI_PASSWORD_LEN + 1];
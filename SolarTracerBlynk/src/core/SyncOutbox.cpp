@@ -0,0 +1,139 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "SyncOutbox.h"
+
+#ifdef USE_SYNC_OUTBOX
+
+#include "../incl/include_all_lib.h"
+
+SyncOutbox::SyncOutbox(const char *persistence) {
+    this->persistence = persistence;
+}
+
+void SyncOutbox::setup() {
+    this->fileRecords = 0;
+    this->fileReadRecords = 0;
+    if (LittleFS.begin()) {
+        if (LittleFS.exists(this->persistence)) {
+            File outboxFile = LittleFS.open(this->persistence, "r");
+            if (outboxFile) {
+                // a torn record at the end is skipped
+                this->fileRecords = outboxFile.size() / sizeof(SyncOutboxRecord);
+                outboxFile.close();
+            }
+        }
+        LittleFS.end();
+    }
+}
+
+bool SyncOutbox::push(Variable variable, float value) {
+    if (this->ramCount == SYNC_OUTBOX_RAM_RECORDS) {
+        this->spill();
+    }
+    if (this->ramCount == SYNC_OUTBOX_RAM_RECORDS) {
+        // file full or not writable: the oldest record is lost
+        this->ramHead = (this->ramHead + 1) % SYNC_OUTBOX_RAM_RECORDS;
+        this->ramCount--;
+        this->droppedCount++;
+    }
+    time_t now = time(nullptr);
+    SyncOutboxRecord *record = &(this->records[(this->ramHead + this->ramCount) % SYNC_OUTBOX_RAM_RECORDS]);
+    record->timestamp = now > 100000ul ? now : 0;
+    record->value = value;
+    record->variable = variable;
+    this->ramCount++;
+    return true;
+}
+
+uint8_t SyncOutbox::peek(SyncOutboxRecord *records, uint8_t count) {
+    uint8_t found = 0;
+    if (this->fileReadRecords < this->fileRecords) {
+        // records in the file are older than the ones in RAM
+        if (LittleFS.begin()) {
+            File outboxFile = LittleFS.open(this->persistence, "r");
+            if (outboxFile && outboxFile.seek(this->fileReadRecords * sizeof(SyncOutboxRecord))) {
+                if (count > this->fileRecords - this->fileReadRecords) {
+                    count = this->fileRecords - this->fileReadRecords;
+                }
+                found = outboxFile.read((uint8_t *)records, count * sizeof(SyncOutboxRecord)) / sizeof(SyncOutboxRecord);
+            }
+            if (outboxFile) {
+                outboxFile.close();
+            }
+            LittleFS.end();
+        }
+        if (found == 0) {
+            // unreadable: give up the file
+            this->droppedCount += this->fileRecords - this->fileReadRecords;
+            this->pop(this->fileRecords - this->fileReadRecords);
+        }
+        return found;
+    }
+    for (; found < count && found < this->ramCount; found++) {
+        records[found] = this->records[(this->ramHead + found) % SYNC_OUTBOX_RAM_RECORDS];
+    }
+    return found;
+}
+
+void SyncOutbox::pop(uint8_t count) {
+    if (this->fileReadRecords < this->fileRecords) {
+        this->fileReadRecords += count;
+        if (this->fileReadRecords >= this->fileRecords) {
+            this->fileReadRecords = 0;
+            this->fileRecords = 0;
+            if (LittleFS.begin()) {
+                LittleFS.remove(this->persistence);
+                LittleFS.end();
+            }
+        }
+        return;
+    }
+    if (count > this->ramCount) {
+        count = this->ramCount;
+    }
+    this->ramHead = (this->ramHead + count) % SYNC_OUTBOX_RAM_RECORDS;
+    this->ramCount -= count;
+}
+
+bool SyncOutbox::spill() {
+    if (this->fileRecords + this->ramCount > SYNC_OUTBOX_FILE_MAX_RECORDS || !LittleFS.begin()) {
+        return false;
+    }
+    File outboxFile = LittleFS.open(this->persistence, "a");
+    if (outboxFile) {
+        // oldest first, what has been written is no longer in RAM even if the file gets full
+        while (this->ramCount > 0 && outboxFile.write((const uint8_t *)&(this->records[this->ramHead]), sizeof(SyncOutboxRecord)) == sizeof(SyncOutboxRecord)) {
+            this->ramHead = (this->ramHead + 1) % SYNC_OUTBOX_RAM_RECORDS;
+            this->ramCount--;
+            this->fileRecords++;
+        }
+        outboxFile.close();
+    }
+    bool written = this->ramCount == 0;
+    if (!written) {
+        debugPrintln("ERROR: cannot write sync outbox");
+    }
+    LittleFS.end();
+    return written;
+}
+
+#endif
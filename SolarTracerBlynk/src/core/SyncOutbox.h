@@ -0,0 +1,108 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#ifndef SYNC_OUTBOX_H
+#define SYNC_OUTBOX_H
+
+#include "../incl/include_all_core.h"
+
+#ifdef USE_SYNC_OUTBOX
+
+#ifndef SYNC_OUTBOX_RAM_RECORDS
+#define SYNC_OUTBOX_RAM_RECORDS 64
+#endif
+#ifndef SYNC_OUTBOX_FILE_MAX_RECORDS
+#define SYNC_OUTBOX_FILE_MAX_RECORDS 4096
+#endif
+
+static_assert(SYNC_OUTBOX_RAM_RECORDS <= 255, "SYNC_OUTBOX_RAM_RECORDS must fit in uint8_t");
+
+/**
+ * Value of a variable that could not be sent
+ */
+struct SyncOutboxRecord {
+        // seconds since epoch, 0 if the time was unknown
+        uint32_t timestamp;
+        float value;
+        uint8_t variable;
+};
+
+/**
+ * Bounded queue of the values to be sent when the server is reachable again.
+ *
+ * The last SYNC_OUTBOX_RAM_RECORDS records are kept in RAM, when full they are appended
+ * to a file in LittleFS (up to SYNC_OUTBOX_FILE_MAX_RECORDS, then the oldest in RAM are dropped).
+ * Records are read back oldest first, the file survives reboots (replay is at least once).
+ */
+class SyncOutbox {
+    public:
+        SyncOutbox(const char *persistence);
+
+        /**
+         * Pick up the records left in the file
+         */
+        void setup();
+
+        bool push(Variable variable, float value);
+
+        inline bool isEmpty() {
+            return this->fileReadRecords == this->fileRecords && this->ramCount == 0;
+        }
+
+        /**
+         * Copy up to count of the oldest records, return how many
+         */
+        uint8_t peek(SyncOutboxRecord *records, uint8_t count);
+
+        /**
+         * Remove count of the oldest records (after they are sent)
+         */
+        void pop(uint8_t count);
+
+        inline uint16_t getDroppedCount() {
+            return this->droppedCount;
+        }
+
+        inline uint16_t getCount() {
+            return this->fileRecords - this->fileReadRecords + this->ramCount;
+        }
+
+    private:
+        const char *persistence;
+
+        SyncOutboxRecord records[SYNC_OUTBOX_RAM_RECORDS];
+        uint8_t ramHead = 0;
+        uint8_t ramCount = 0;
+
+        uint16_t fileRecords = 0;
+        uint16_t fileReadRecords = 0;
+        uint16_t droppedCount = 0;
+
+        /**
+         * Append the RAM records to the file
+         */
+        bool spill();
+};
+
+#endif
+#endif
@@ -0,0 +1,226 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "SyncRegistry.h"
+
+#include "../core/Controller.h"
+#include "../core/Environment.h"
+#include "../core/debug.h"
+
+SyncBackendEntry SyncRegistry::entries[SYNC_REGISTRY_MAX_BACKENDS];
+uint8_t SyncRegistry::count;
+#ifdef USE_SYNC_DIAGNOSTICS
+char SyncRegistry::diagnosticsBuffer[SYNC_DIAGNOSTICS_BUFFER_SIZE];
+#endif
+
+bool SyncRegistry::add(const char *name, BaseSync &(*getInstance)(), const char *dependsOn) {
+    if (count >= SYNC_REGISTRY_MAX_BACKENDS) {
+        return false;
+    }
+    SyncBackendEntry *entry = &(entries[count++]);
+    entry->name = name;
+    entry->getInstance = getInstance;
+    entry->dependsOn = dependsOn;
+    return true;
+}
+
+bool SyncRegistry::isListed(const char *list, const char *name) {
+    size_t nameLength = strlen(name);
+    while (*list != '\0') {
+        while (*list == ' ' || *list == ',') {
+            list++;
+        }
+        const char *end = list;
+        while (*end != '\0' && *end != ',' && *end != ' ') {
+            end++;
+        }
+        if ((size_t)(end - list) == nameLength && strncmp(list, name, nameLength) == 0) {
+            return true;
+        }
+        list = end;
+    }
+    return false;
+}
+
+void SyncRegistry::setup(SyncBackendEntry *entry) {
+    entry->getInstance().setup();
+    entry->initialized = true;
+    entry->nextLoopMillis = millis();
+}
+
+void SyncRegistry::setupAll() {
+    for (uint8_t index = 0; index < count; index++) {
+        const char *dependsOn = entries[index].dependsOn;
+        entries[index].enabled = !isListed(Environment::getData()->syncDisabled, entries[index].name);
+        if (entries[index].enabled && dependsOn != nullptr && isListed(Environment::getData()->syncDisabled, dependsOn)) {
+            debugPrintf(true, "%s sync needs %s", entries[index].name, dependsOn);
+            entries[index].enabled = false;
+        }
+        if (entries[index].enabled) {
+            setup(&(entries[index]));
+        } else {
+            debugPrintf(true, "%s sync disabled", entries[index].name);
+        }
+    }
+}
+
+void SyncRegistry::uploadRealtimeAll() {
+    for (uint8_t index = 0; index < count; index++) {
+        if (entries[index].enabled) {
+            entries[index].getInstance().uploadRealtime();
+        }
+    }
+}
+
+void SyncRegistry::uploadStatsAll() {
+    for (uint8_t index = 0; index < count; index++) {
+        if (entries[index].enabled) {
+            entries[index].getInstance().uploadStats();
+        }
+    }
+}
+
+#ifdef USE_SYNC_ON_CHANGE
+void SyncRegistry::uploadRealtimeOnChangeAll() {
+    for (uint8_t index = 0; index < count; index++) {
+        if (entries[index].enabled) {
+            BaseSync &backend = entries[index].getInstance();
+            if (backend.isSyncOnChangeAllowed(VariableSource::SR_REALTIME)) {
+                backend.uploadRealtime();
+            }
+        }
+    }
+}
+#endif
+
+void SyncRegistry::loopAll() {
+    for (uint8_t index = 0; index < count; index++) {
+        SyncBackendEntry *entry = &(entries[index]);
+        if (!entry->enabled || (int32_t)(millis() - entry->nextLoopMillis) < 0) {
+            continue;
+        }
+        BaseSync &backend = entry->getInstance();
+        uint32_t startMicros = micros();
+        backend.loop();
+        entry->lastLoopMicros = micros() - startMicros;
+        if (entry->lastLoopMicros > entry->maxLoopMicros) {
+            entry->maxLoopMicros = entry->lastLoopMicros;
+        }
+        entry->loopCount++;
+        entry->nextLoopMillis = backend.getLoopDeadline(millis());
+    }
+}
+
+#ifdef USE_VARIABLE_RULES
+uint8_t SyncRegistry::sendAlarmAll(const char *message) {
+    uint8_t notified = 0;
+    for (uint8_t index = 0; index < count; index++) {
+        if (entries[index].enabled && entries[index].getInstance().sendAlarm(message)) {
+            notified++;
+        }
+    }
+    return notified;
+}
+#endif
+
+#ifdef USE_SYNC_DIAGNOSTICS
+size_t SyncRegistry::getDiagnostics(uint8_t index, char *buffer, size_t size) {
+    const SyncBackendEntry *entry = getEntry(index);
+    if (entry == nullptr || !entry->initialized) {
+        // not created
+        return snprintf(buffer, size, "{\"enabled\":0}");
+    }
+    BaseSync &backend = entry->getInstance();
+    const SyncMetrics *metrics = backend.getMetrics();
+    size_t length = snprintf(buffer, size,
+                             "{\"enabled\":%u,\"sent\":%lu,\"bytes\":%lu,\"failed\":%lu,\"notReady\":%lu,\"suppressed\":%lu,\"delayed\":%lu,"
+                             "\"throttled\":[%u,%u,%u,%u],\"pending\":%u,\"queued\":%u,\"dropped\":%u,\"loops\":%lu,\"loopUs\":%lu,\"loopMaxUs\":%lu,\"vars\":[",
+                             entry->enabled, (unsigned long)metrics->sent, (unsigned long)metrics->bytes, (unsigned long)metrics->failed,
+                             (unsigned long)metrics->notReady, (unsigned long)metrics->suppressed, (unsigned long)metrics->delayed,
+                             backend.getThrottledCount(SP_ALARM), backend.getThrottledCount(SP_REALTIME), backend.getThrottledCount(SP_STATS), backend.getThrottledCount(SP_SETTINGS),
+                             backend.getPendingCount(), backend.getQueuedCount(), backend.getDroppedCount(),
+                             (unsigned long)entry->loopCount, (unsigned long)entry->lastLoopMicros, (unsigned long)entry->maxLoopMicros);
+    uint32_t now = millis();
+    bool first = true;
+    for (uint8_t variable = 0; variable < Variable::VARIABLES_COUNT && length < size; variable++) {
+        if (backend.getSendCount((Variable)variable) == 0) {
+            continue;
+        }
+        if (length + 24 >= size) {
+            // no room left, the list is cut
+            break;
+        }
+        length += snprintf(buffer + length, size - length, "%s[%u,%lu,%u]", first ? "" : ",", variable,
+                           (unsigned long)((now - backend.getLastSentMillis((Variable)variable)) / 1000), backend.getSendCount((Variable)variable));
+        first = false;
+    }
+    if (length + 3 <= size) {
+        length += snprintf(buffer + length, size - length, "]}");
+    }
+    return length;
+}
+
+size_t SyncRegistry::getFilterDiagnostics(char *buffer, size_t size) {
+    SolarTracer *solarT = Controller::getInstance().getSolarController();
+    size_t length = snprintf(buffer, size, "{\"filters\":[");
+    bool first = true;
+    for (uint8_t index = 0; index < FILTERED_VARIABLES_COUNT && length < size; index++) {
+        Variable variable = VariableDefiner::getInstance().getFilterDefinition(index)->variable;
+        if (!solarT->isVariableReadReady(variable)) {
+            continue;
+        }
+        if (length + 40 >= size) {
+            // no room left, the list is cut
+            break;
+        }
+        length += snprintf(buffer + length, size - length, "%s[%u,%.3f,%.3f]", first ? "" : ",", variable,
+                           solarT->getRawValue(variable), *(const float *)solarT->getValue(variable));
+        first = false;
+    }
+    if (length + 3 <= size) {
+        length += snprintf(buffer + length, size - length, "]}");
+    }
+    return length;
+}
+
+void SyncRegistry::sendDiagnostics(const char *name, const char *json) {
+    bool sent = false;
+    for (uint8_t sender = 0; sender < count && !sent; sender++) {
+        sent = entries[sender].enabled && entries[sender].getInstance().sendDiagnostics(name, json);
+    }
+    if (!sent) {
+        debugPrint(name);
+        debugPrint(" sync: ");
+        debugPrintln(json);
+    }
+}
+
+void SyncRegistry::sendDiagnosticsAll() {
+    for (uint8_t index = 0; index < count; index++) {
+        getDiagnostics(index, diagnosticsBuffer, sizeof(diagnosticsBuffer));
+        sendDiagnostics(entries[index].name, diagnosticsBuffer);
+    }
+    if (FILTERED_VARIABLES_COUNT > 0) {
+        getFilterDiagnostics(diagnosticsBuffer, sizeof(diagnosticsBuffer));
+        sendDiagnostics("filter", diagnosticsBuffer);
+    }
+}
+#endif
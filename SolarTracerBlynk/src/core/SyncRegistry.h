@@ -0,0 +1,132 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#ifndef SYNC_REGISTRY_H
+#define SYNC_REGISTRY_H
+
+#include "../core/BaseSync.h"
+#include "../incl/include_all_core.h"
+
+#ifndef SYNC_REGISTRY_MAX_BACKENDS
+#define SYNC_REGISTRY_MAX_BACKENDS 4
+#endif
+#ifndef SYNC_DIAGNOSTICS_BUFFER_SIZE
+#define SYNC_DIAGNOSTICS_BUFFER_SIZE 1536
+#endif
+
+/**
+ * Sync backend known by the registry, with its loop timing
+ */
+struct SyncBackendEntry {
+        const char *name;
+        // the backend is created when first used (after the environment is loaded)
+        BaseSync &(*getInstance)();
+        // backend running the connection this one relies on, disabled along with it (nullptr if none)
+        const char *dependsOn;
+        bool enabled;
+        bool initialized;
+        uint32_t nextLoopMillis;
+        uint32_t loopCount;
+        // duration of the last and the slowest call of loop() (us)
+        uint32_t lastLoopMicros;
+        uint32_t maxLoopMicros;
+};
+
+/**
+ * Sync backends, registered by the sketch setup (see SyncRegistry::add) and synced in registration order.
+ *
+ * The backends listed in the environment data (syncDisabled) are not started.
+ */
+class SyncRegistry {
+    public:
+        /**
+         * Register a backend, before setupAll()
+         */
+        static bool add(const char *name, BaseSync &(*getInstance)(), const char *dependsOn = nullptr);
+
+        static void setupAll();
+        static void uploadRealtimeAll();
+        static void uploadStatsAll();
+#ifdef USE_SYNC_ON_CHANGE
+        static void uploadRealtimeOnChangeAll();
+#endif
+        /**
+         * Call loop() of the enabled backends whose deadline is expired
+         */
+        static void loopAll();
+
+#ifdef USE_VARIABLE_RULES
+        /**
+         * Notify the alarm through each enabled backend able to, return the count of backends notified
+         */
+        static uint8_t sendAlarmAll(const char *message);
+#endif
+
+#ifdef USE_SYNC_DIAGNOSTICS
+        /**
+         * Send the diagnostics of each backend through the first enabled backend able to, print them on the debug serial otherwise
+         */
+        static void sendDiagnosticsAll();
+
+        /**
+         * Diagnostics of a backend as JSON:
+         * {"enabled":1,"sent":n,"bytes":n,"failed":n,"notReady":n,"suppressed":n,"delayed":n,"throttled":[alarm,realtime,stats,settings],
+         *  "pending":n,"queued":n,"dropped":n,"loops":n,"loopUs":n,"loopMaxUs":n,"vars":[[variable,seconds since last sent,send count],...]}
+         */
+        static size_t getDiagnostics(uint8_t index, char *buffer, size_t size);
+
+        /**
+         * Filtered variables (VARIABLE_FILTER_LIST) as JSON: {"filters":[[variable,last value read,filtered value],...]}
+         */
+        static size_t getFilterDiagnostics(char *buffer, size_t size);
+#endif
+
+        static uint8_t getCount() {
+            return count;
+        }
+
+        static const SyncBackendEntry *getEntry(uint8_t index) {
+            return index < count ? &(entries[index]) : nullptr;
+        }
+
+    private:
+        /**
+         * Check if name is in the comma separated list
+         */
+        static bool isListed(const char *list, const char *name);
+
+        static void setup(SyncBackendEntry *entry);
+
+#ifdef USE_SYNC_DIAGNOSTICS
+        static void sendDiagnostics(const char *name, const char *json);
+#endif
+
+        static SyncBackendEntry entries[SYNC_REGISTRY_MAX_BACKENDS];
+        static uint8_t count;
+
+#ifdef USE_SYNC_DIAGNOSTICS
+        static char diagnosticsBuffer[SYNC_DIAGNOSTICS_BUFFER_SIZE];
+#endif
+};
+
+#endif
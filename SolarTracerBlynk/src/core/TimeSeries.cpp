@@ -0,0 +1,220 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "TimeSeries.h"
+
+// bits of the value for each prefix code: 10, 110, 1110, 1111 (0 means unchanged)
+static const uint8_t TIME_SERIES_TIME_BUCKETS[] = {7, 9, 12, 32};
+static const uint8_t TIME_SERIES_VALUE_BUCKETS[] = {4, 8, 16, 32};
+
+TimeSeries::TimeSeries() {
+    this->clear();
+}
+
+void TimeSeries::clear() {
+    this->firstBlock = 0;
+    this->blockCount = 0;
+    this->lastTime = 0;
+    this->lastTimeDelta = 0;
+    this->lastValue = 0;
+}
+
+void TimeSeries::append(uint32_t time, float value) {
+    int32_t scaledValue = (int32_t)lroundf(value * TIME_SERIES_VALUE_SCALE);
+
+    if (this->blockCount > 0 && time >= this->lastTime) {
+        TimeSeriesBlock *block = this->getBlock(this->blockCount - 1);
+        int32_t timeDelta = time - this->lastTime;
+        uint32_t timeCode = TimeSeries::zigZagEncode(timeDelta - this->lastTimeDelta);
+        uint32_t valueCode = TimeSeries::zigZagEncode(scaledValue - this->lastValue);
+
+        if (block->bitCount + TimeSeries::getEncodedSize(TIME_SERIES_TIME_BUCKETS, timeCode) + TimeSeries::getEncodedSize(TIME_SERIES_VALUE_BUCKETS, valueCode) <= TIME_SERIES_BLOCK_SIZE * 8) {
+            TimeSeries::writeEncoded(block, TIME_SERIES_TIME_BUCKETS, timeCode);
+            TimeSeries::writeEncoded(block, TIME_SERIES_VALUE_BUCKETS, valueCode);
+            block->count++;
+            block->lastTime = time;
+
+            this->lastTime = time;
+            this->lastTimeDelta = timeDelta;
+            this->lastValue = scaledValue;
+            return;
+        }
+    }
+
+    this->startBlock(time, scaledValue);
+}
+
+void TimeSeries::startBlock(uint32_t time, int32_t value) {
+    if (this->blockCount == TIME_SERIES_BLOCK_COUNT) {
+        // drop the oldest block
+        this->firstBlock = (this->firstBlock + 1) % TIME_SERIES_BLOCK_COUNT;
+        this->blockCount--;
+    }
+    TimeSeriesBlock *block = this->getBlock(this->blockCount++);
+    block->firstTime = time;
+    block->lastTime = time;
+    block->firstValue = value;
+    block->count = 1;
+    block->bitCount = 0;
+    memset(block->data, 0, TIME_SERIES_BLOCK_SIZE);
+
+    this->lastTime = time;
+    this->lastTimeDelta = 0;
+    this->lastValue = value;
+}
+
+template <typename F>
+void TimeSeries::forEach(uint32_t from, uint32_t to, F onSample) {
+    for (uint8_t index = 0; index < this->blockCount; index++) {
+        const TimeSeriesBlock *block = this->getBlock(index);
+        // skipped without decoding
+        if (block->lastTime < from || block->firstTime > to) {
+            continue;
+        }
+
+        uint32_t time = block->firstTime;
+        int32_t timeDelta = 0;
+        int32_t value = block->firstValue;
+        uint16_t bitIndex = 0;
+        for (uint16_t sampleIndex = 0; sampleIndex < block->count; sampleIndex++) {
+            if (sampleIndex > 0) {
+                timeDelta += TimeSeries::zigZagDecode(TimeSeries::readEncoded(block, bitIndex, TIME_SERIES_TIME_BUCKETS));
+                time += timeDelta;
+                value += TimeSeries::zigZagDecode(TimeSeries::readEncoded(block, bitIndex, TIME_SERIES_VALUE_BUCKETS));
+            }
+            if (time > to) {
+                break;
+            }
+            if (time >= from && !onSample(time, value)) {
+                return;
+            }
+        }
+    }
+}
+
+uint16_t TimeSeries::read(uint32_t from, uint32_t to, TimeSeriesSample *samples, uint16_t maxSamples) {
+    uint16_t count = 0;
+    this->forEach(from, to, [&](uint32_t time, int32_t value) {
+        if (count >= maxSamples) {
+            return false;
+        }
+        samples[count].time = time;
+        samples[count].value = value / (float)TIME_SERIES_VALUE_SCALE;
+        count++;
+        return true;
+    });
+    return count;
+}
+
+bool TimeSeries::aggregate(uint32_t from, uint32_t to, TimeSeriesAggregate &result) {
+    int64_t sum = 0;
+    int32_t minValue = INT32_MAX;
+    int32_t maxValue = INT32_MIN;
+    result.count = 0;
+    this->forEach(from, to, [&](uint32_t time, int32_t value) {
+        if (result.count == 0) {
+            result.firstTime = time;
+        }
+        result.lastTime = time;
+        result.count++;
+        sum += value;
+        minValue = value < minValue ? value : minValue;
+        maxValue = value > maxValue ? value : maxValue;
+        return result.count < UINT16_MAX;
+    });
+    if (result.count == 0) {
+        return false;
+    }
+    result.min = minValue / (float)TIME_SERIES_VALUE_SCALE;
+    result.max = maxValue / (float)TIME_SERIES_VALUE_SCALE;
+    result.mean = sum / (float)result.count / TIME_SERIES_VALUE_SCALE;
+    return true;
+}
+
+uint32_t TimeSeries::getSampleCount() {
+    uint32_t count = 0;
+    for (uint8_t index = 0; index < this->blockCount; index++) {
+        count += this->getBlock(index)->count;
+    }
+    return count;
+}
+
+uint32_t TimeSeries::getUsedBytes() {
+    uint32_t bytes = 0;
+    for (uint8_t index = 0; index < this->blockCount; index++) {
+        bytes += sizeof(TimeSeriesBlock) - TIME_SERIES_BLOCK_SIZE + (this->getBlock(index)->bitCount + 7) / 8;
+    }
+    return bytes;
+}
+
+uint8_t TimeSeries::getEncodedSize(const uint8_t *bucketBits, uint32_t value) {
+    if (value == 0) {
+        return 1;
+    }
+    uint8_t bucket = 0;
+    while (bucket < 3 && value >= (1UL << bucketBits[bucket])) {
+        bucket++;
+    }
+    return (bucket < 3 ? bucket + 2 : 4) + bucketBits[bucket];
+}
+
+void TimeSeries::writeEncoded(TimeSeriesBlock *block, const uint8_t *bucketBits, uint32_t value) {
+    if (value == 0) {
+        TimeSeries::writeBits(block, 0, 1);
+        return;
+    }
+    uint8_t bucket = 0;
+    while (bucket < 3 && value >= (1UL << bucketBits[bucket])) {
+        bucket++;
+    }
+    // prefix: one 1 for each bucket, terminated by 0 except for the last bucket
+    TimeSeries::writeBits(block, bucket < 3 ? (1 << (bucket + 2)) - 2 : 0xF, bucket < 3 ? bucket + 2 : 4);
+    TimeSeries::writeBits(block, value, bucketBits[bucket]);
+}
+
+uint32_t TimeSeries::readEncoded(const TimeSeriesBlock *block, uint16_t &bitIndex, const uint8_t *bucketBits) {
+    if (TimeSeries::readBits(block, bitIndex, 1) == 0) {
+        return 0;
+    }
+    uint8_t bucket = 0;
+    while (bucket < 3 && TimeSeries::readBits(block, bitIndex, 1) == 1) {
+        bucket++;
+    }
+    return TimeSeries::readBits(block, bitIndex, bucketBits[bucket]);
+}
+
+void TimeSeries::writeBits(TimeSeriesBlock *block, uint32_t value, uint8_t bits) {
+    while (bits-- > 0) {
+        if ((value >> bits) & 1) {
+            block->data[block->bitCount >> 3] |= 0x80 >> (block->bitCount & 7);
+        }
+        block->bitCount++;
+    }
+}
+
+uint32_t TimeSeries::readBits(const TimeSeriesBlock *block, uint16_t &bitIndex, uint8_t bits) {
+    uint32_t value = 0;
+    while (bits-- > 0) {
+        value = (value << 1) | ((block->data[bitIndex >> 3] >> (7 - (bitIndex & 7))) & 1);
+        bitIndex++;
+    }
+    return value;
+}
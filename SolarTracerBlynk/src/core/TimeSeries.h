@@ -0,0 +1,141 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#ifndef TIME_SERIES_H
+#define TIME_SERIES_H
+
+#include "../incl/include_all_core.h"
+
+// bytes of compressed samples in each block
+#ifndef TIME_SERIES_BLOCK_SIZE
+#define TIME_SERIES_BLOCK_SIZE 256
+#endif
+// blocks of each time series, when all are full the oldest one is dropped
+#ifndef TIME_SERIES_BLOCK_COUNT
+#define TIME_SERIES_BLOCK_COUNT 8
+#endif
+// values are stored as integers: resolution of 0.01 as the values read from the scc
+#define TIME_SERIES_VALUE_SCALE 100
+
+struct TimeSeriesSample {
+        // seconds
+        uint32_t time;
+        float value;
+};
+
+struct TimeSeriesAggregate {
+        uint16_t count;
+        float min;
+        float max;
+        float mean;
+        uint32_t firstTime;
+        uint32_t lastTime;
+};
+
+/**
+ * Block of samples: the first one is stored in the header, the others are compressed into data
+ */
+struct TimeSeriesBlock {
+        uint32_t firstTime;
+        uint32_t lastTime;
+        int32_t firstValue;
+        uint16_t count;
+        uint16_t bitCount;
+        uint8_t data[TIME_SERIES_BLOCK_SIZE];
+};
+
+/**
+ * Fixed memory ring buffer of samples.
+ *
+ * Samples are compressed Gorilla style: timestamps as delta of delta, values
+ * as delta of the scaled integer, both with a variable length prefix code.
+ * A regular sampling of a steady value costs 2 bits.
+ */
+class TimeSeries {
+    public:
+        TimeSeries();
+
+        /**
+         * Add a sample, times are expected to be increasing (a step back starts a new block)
+         */
+        void append(uint32_t time, float value);
+
+        void clear();
+
+        /**
+         * Copy the samples between from and to (inclusive) into samples, return the number of samples copied
+         */
+        uint16_t read(uint32_t from, uint32_t to, TimeSeriesSample *samples, uint16_t maxSamples);
+
+        /**
+         * Min/max/mean of the samples between from and to (inclusive), false if there are no samples
+         */
+        bool aggregate(uint32_t from, uint32_t to, TimeSeriesAggregate &result);
+
+        uint32_t getSampleCount();
+
+        /**
+         * Bytes actually used by the compressed samples (headers included)
+         */
+        uint32_t getUsedBytes();
+
+    private:
+        TimeSeriesBlock blocks[TIME_SERIES_BLOCK_COUNT];
+        // oldest block
+        uint8_t firstBlock;
+        uint8_t blockCount;
+
+        // state of the last sample appended
+        uint32_t lastTime;
+        int32_t lastTimeDelta;
+        int32_t lastValue;
+
+        inline TimeSeriesBlock *getBlock(uint8_t index) {
+            return &(this->blocks[(this->firstBlock + index) % TIME_SERIES_BLOCK_COUNT]);
+        }
+
+        void startBlock(uint32_t time, int32_t value);
+
+        /**
+         * Call onSample for each sample between from and to, stop when it returns false
+         */
+        template <typename F>
+        void forEach(uint32_t from, uint32_t to, F onSample);
+
+        static uint8_t getEncodedSize(const uint8_t *bucketBits, uint32_t value);
+        static void writeEncoded(TimeSeriesBlock *block, const uint8_t *bucketBits, uint32_t value);
+        static uint32_t readEncoded(const TimeSeriesBlock *block, uint16_t &bitIndex, const uint8_t *bucketBits);
+
+        static void writeBits(TimeSeriesBlock *block, uint32_t value, uint8_t bits);
+        static uint32_t readBits(const TimeSeriesBlock *block, uint16_t &bitIndex, uint8_t bits);
+
+        static inline uint32_t zigZagEncode(int32_t value) {
+            return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+        }
+
+        static inline int32_t zigZagDecode(uint32_t value) {
+            return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+        }
+};
+
+#endif
@@ -23,106 +23,303 @@
 
 #include "../incl/include_all_core.h"
 
-VariableDefiner::VariableDefiner() {
-    this->variables = new VariableDefinition[Variable::VARIABLES_COUNT]();
-
-    this->initializeVariable(Variable::PV_VOLTAGE, "PV volt.", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_PV_VOLTAGE_DF, MQTT_TOPIC_PV_VOLTAGE_DF);
-    this->initializeVariable(Variable::PV_POWER, "PV power", VariableDatatype::DT_FLOAT, VariableUOM::UOM_WATT, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_PV_POWER_DF, MQTT_TOPIC_PV_POWER_DF);
-    this->initializeVariable(Variable::PV_CURRENT, "PV current", VariableDatatype::DT_FLOAT, VariableUOM::UOM_AMPERE, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_PV_CURRENT_DF, MQTT_TOPIC_PV_CURRENT_DF);
-    this->initializeVariable(Variable::LOAD_CURRENT, "Load current", VariableDatatype::DT_FLOAT, VariableUOM::UOM_AMPERE, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_LOAD_CURRENT_DF, MQTT_TOPIC_LOAD_CURRENT_DF);
-    this->initializeVariable(Variable::LOAD_POWER, "Load power", VariableDatatype::DT_FLOAT, VariableUOM::UOM_WATT, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_LOAD_POWER_DF, MQTT_TOPIC_LOAD_POWER_DF);
-    this->initializeVariable(Variable::BATTERY_TEMP, "Batt. temp", VariableDatatype::DT_FLOAT, VariableUOM::UOM_TEMPERATURE_C, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_BATT_TEMP_DF, MQTT_TOPIC_BATT_TEMP_DF);
-    this->initializeVariable(Variable::BATTERY_VOLTAGE, "Batt. volt.", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_BATT_VOLTAGE_DF, MQTT_TOPIC_BATT_VOLTAGE_DF);
-    this->initializeVariable(Variable::BATTERY_SOC, "Batt. SOC", VariableDatatype::DT_FLOAT, VariableUOM::UOM_PERCENT, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_BATT_REMAIN_DF, MQTT_TOPIC_BATT_REMAIN_DF);
-    this->initializeVariable(Variable::CONTROLLER_TEMP, "Controller temp.", VariableDatatype::DT_FLOAT, VariableUOM::UOM_TEMPERATURE_C, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_CONTROLLER_TEMP_DF, MQTT_TOPIC_CONTROLLER_TEMP_DF);
-    this->initializeVariable(Variable::BATTERY_CHARGE_CURRENT, "Charging current", VariableDatatype::DT_FLOAT, VariableUOM::UOM_AMPERE, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_BATTERY_CHARGE_CURRENT_DF, MQTT_TOPIC_BATTERY_CHARGE_CURRENT_DF);
-    this->initializeVariable(Variable::BATTERY_CHARGE_POWER, "Charging power", VariableDatatype::DT_FLOAT, VariableUOM::UOM_WATT, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_BATTERY_CHARGE_POWER_DF, MQTT_TOPIC_BATTERY_CHARGE_POWER_DF);
-    this->initializeVariable(Variable::BATTERY_OVERALL_CURRENT, "Overall current", VariableDatatype::DT_FLOAT, VariableUOM::UOM_AMPERE, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_BATTERY_OVERALL_CURRENT_DF, MQTT_TOPIC_BATTERY_OVERALL_CURRENT_DF);
-    this->initializeVariable(Variable::REALTIME_CLOCK, "Date and time", VariableDatatype::DT_FLOAT, VariableUOM::UOM_UNDEFINED, VariableSource::SR_INTERNAL, VariableMode::MD_READWRITE, vPIN_UPDATE_CONTROLLER_DATETIME_DF, MQTT_TOPIC_UPDATE_CONTROLLER_DATETIME_DF);
-    this->initializeVariable(Variable::LOAD_FORCE_ONOFF, "Load force switch", VariableDatatype::DT_BOOL, VariableUOM::UOM_UNDEFINED, VariableSource::SR_REALTIME, VariableMode::MD_READ, nullptr, nullptr);
-    this->initializeVariable(Variable::LOAD_MANUAL_ONOFF, "Load switch", VariableDatatype::DT_BOOL, VariableUOM::UOM_UNDEFINED, VariableSource::SR_REALTIME, VariableMode::MD_READWRITE, vPIN_LOAD_ENABLED_DF, MQTT_TOPIC_LOAD_ENABLED_DF);
-    this->initializeVariable(Variable::REMOTE_BATTERY_TEMP, "Remote batt. temp.", VariableDatatype::DT_FLOAT, VariableUOM::UOM_TEMPERATURE_C, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_BATT_TEMP_DF, MQTT_TOPIC_BATT_TEMP_DF);
-    this->initializeVariable(Variable::CONSUMED_ENERGY_TODAY, "Energy consumed today", VariableDatatype::DT_FLOAT, VariableUOM::UOM_KILOWATTHOUR, VariableSource::SR_STATS, VariableMode::MD_READ, vPIN_STAT_ENERGY_CONSUMED_TODAY_DF, MQTT_TOPIC_STAT_ENERGY_CONSUMED_TODAY_DF);
-    this->initializeVariable(Variable::CONSUMED_ENERGY_MONTH, "Energy consumed month", VariableDatatype::DT_FLOAT, VariableUOM::UOM_KILOWATTHOUR, VariableSource::SR_STATS, VariableMode::MD_READ, vPIN_STAT_ENERGY_CONSUMED_THIS_MONTH_DF, MQTT_TOPIC_STAT_ENERGY_CONSUMED_THIS_MONTH_DF);
-    this->initializeVariable(Variable::CONSUMED_ENERGY_YEAR, "Energy consumed year", VariableDatatype::DT_FLOAT, VariableUOM::UOM_KILOWATTHOUR, VariableSource::SR_STATS, VariableMode::MD_READ, vPIN_STAT_ENERGY_CONSUMED_THIS_YEAR_DF, MQTT_TOPIC_STAT_ENERGY_CONSUMED_THIS_YEAR_DF);
-    this->initializeVariable(Variable::CONSUMED_ENERGY_TOTAL, "Energy consumed", VariableDatatype::DT_FLOAT, VariableUOM::UOM_KILOWATTHOUR, VariableSource::SR_STATS, VariableMode::MD_READ, vPIN_STAT_ENERGY_CONSUMED_TOTAL_DF, MQTT_TOPIC_STAT_ENERGY_CONSUMED_TOTAL_DF);
-    this->initializeVariable(Variable::GENERATED_ENERGY_TODAY, "Energy generated today", VariableDatatype::DT_FLOAT, VariableUOM::UOM_KILOWATTHOUR, VariableSource::SR_STATS, VariableMode::MD_READ, vPIN_STAT_ENERGY_GENERATED_TODAY_DF, MQTT_TOPIC_STAT_ENERGY_GENERATED_TODAY_DF);
-    this->initializeVariable(Variable::GENERATED_ENERGY_MONTH, "Energy generated month", VariableDatatype::DT_FLOAT, VariableUOM::UOM_KILOWATTHOUR, VariableSource::SR_STATS, VariableMode::MD_READ, vPIN_STAT_ENERGY_GENERATED_THIS_MONTH_DF, MQTT_TOPIC_STAT_ENERGY_GENERATED_THIS_MONTH_DF);
-    this->initializeVariable(Variable::GENERATED_ENERGY_YEAR, "Energy generated year", VariableDatatype::DT_FLOAT, VariableUOM::UOM_KILOWATTHOUR, VariableSource::SR_STATS, VariableMode::MD_READ, vPIN_STAT_ENERGY_GENERATED_THIS_YEAR_DF, MQTT_TOPIC_STAT_ENERGY_GENERATED_THIS_YEAR_DF);
-    this->initializeVariable(Variable::GENERATED_ENERGY_TOTAL, "Energy generated", VariableDatatype::DT_FLOAT, VariableUOM::UOM_KILOWATTHOUR, VariableSource::SR_STATS, VariableMode::MD_READ, vPIN_STAT_ENERGY_GENERATED_TOTAL_DF, MQTT_TOPIC_STAT_ENERGY_GENERATED_TOTAL_DF);
-    this->initializeVariable(Variable::MAXIMUM_PV_VOLTAGE_TODAY, "Today PV max. volt.", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READ, vPIN_MAX_PV_VOLTAGE_TODAY_DF, MQTT_TOPIC_MAX_PV_VOLTAGE_TODAY_DF);
-    this->initializeVariable(Variable::MINIMUM_PV_VOLTAGE_TODAY, "Today PV min. volt.", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READ, vPIN_MIN_PV_VOLTAGE_TODAY_DF, MQTT_TOPIC_MIN_PV_VOLTAGE_TODAY_DF);
-    this->initializeVariable(Variable::MAXIMUM_BATTERY_VOLTAGE_TODAY, "Today batt. max. volt.", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READ, vPIN_MAX_BATTERY_VOLTAGE_TODAY_DF, MQTT_TOPIC_MAX_BATTERY_VOLTAGE_TODAY_DF);
-    this->initializeVariable(Variable::MINIMUM_BATTERY_VOLTAGE_TODAY, "Today batt. min. volt.", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READ, vPIN_MIN_BATTERY_VOLTAGE_TODAY_DF, MQTT_TOPIC_MIN_BATTERY_VOLTAGE_TODAY_DF);
-    this->initializeVariable(Variable::BATTERY_BOOST_VOLTAGE, "Boost volt.", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_BOOST_VOLTAGE_DF, MQTT_TOPIC_BATTERY_BOOST_VOLTAGE_DF);
-    this->initializeVariable(Variable::BATTERY_EQUALIZATION_VOLTAGE, "Equalization volt.", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_EQUALIZATION_VOLTAGE_DF, MQTT_TOPIC_BATTERY_EQUALIZATION_VOLTAGE_DF);
-    this->initializeVariable(Variable::BATTERY_FLOAT_VOLTAGE, "Float volt.", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_FLOAT_VOLTAGE_DF, MQTT_TOPIC_BATTERY_FLOAT_VOLTAGE_DF);
-    this->initializeVariable(Variable::BATTERY_FLOAT_MIN_VOLTAGE, "Float min. volt.", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_FLOAT_MIN_VOLTAGE_DF, MQTT_TOPIC_BATTERY_FLOAT_MIN_VOLTAGE_DF);
-    this->initializeVariable(Variable::BATTERY_CHARGING_LIMIT_VOLTAGE, "Charging volt. limit", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_CHARGING_LIMIT_VOLTAGE_DF, MQTT_TOPIC_BATTERY_CHARGING_LIMIT_VOLTAGE_DF);
-    this->initializeVariable(Variable::BATTERY_DISCHARGING_LIMIT_VOLTAGE, "Discharging volt. limit", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_DISCHARGING_LIMIT_VOLTAGE_DF, MQTT_TOPIC_BATTERY_DISCHARGING_LIMIT_VOLTAGE_DF);
-    this->initializeVariable(Variable::BATTERY_LOW_VOLTAGE_DISCONNECT, "Low volt. disconnect", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_LOW_VOLTAGE_DISCONNECT_DF, MQTT_TOPIC_BATTERY_LOW_VOLTAGE_DISCONNECT_DF);
-    this->initializeVariable(Variable::BATTERY_LOW_VOLTAGE_RECONNECT, "Low volt. reconnect", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_LOW_VOLTAGE_RECONNECT_DF, MQTT_TOPIC_BATTERY_LOW_VOLTAGE_RECONNECT_DF);
-    this->initializeVariable(Variable::BATTERY_OVER_VOLTAGE_DISCONNECT, "Over volt. disconnect", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_OVER_VOLTAGE_DISCONNECT_DF, MQTT_TOPIC_BATTERY_OVER_VOLTAGE_DISCONNECT_DF);
-    this->initializeVariable(Variable::BATTERY_OVER_VOLTAGE_RECONNECT, "Over volt. reconnect", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_OVER_VOLTAGE_RECONNECT_DF, MQTT_TOPIC_BATTERY_OVER_VOLTAGE_RECONNECT_DF);
-    this->initializeVariable(Variable::BATTERY_UNDER_VOLTAGE_SET, "Under volt. alarm set", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_UNDER_VOLTAGE_SET_DF, MQTT_TOPIC_BATTERY_UNDER_VOLTAGE_SET_DF);
-    this->initializeVariable(Variable::BATTERY_UNDER_VOLTAGE_RESET, "Under volt. alarm reset", VariableDatatype::DT_FLOAT, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_UNDER_VOLTAGE_RESET_DF, MQTT_TOPIC_BATTERY_UNDER_VOLTAGE_RESET_DF);
-    this->initializeVariable(Variable::BATTERY_STATUS_TEXT, "Batt. status", VariableDatatype::DT_STRING, VariableUOM::UOM_UNDEFINED, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_BATTERY_STATUS_TEXT_DF, MQTT_TOPIC_BATTERY_STATUS_TEXT_DF);
-    this->initializeVariable(Variable::CHARGING_EQUIPMENT_STATUS_TEXT, "Charging status", VariableDatatype::DT_STRING, VariableUOM::UOM_UNDEFINED, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_CHARGING_EQUIPMENT_STATUS_TEXT_DF, MQTT_TOPIC_CHARGING_EQUIPMENT_STATUS_TEXT_DF);
-    this->initializeVariable(Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT, "Discharging status", VariableDatatype::DT_STRING, VariableUOM::UOM_UNDEFINED, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_DISCHARGING_EQUIPMENT_STATUS_TEXT_DF, MQTT_TOPIC_DISCHARGING_EQUIPMENT_STATUS_TEXT_DF);
-    this->initializeVariable(Variable::CHARGING_DEVICE_ONOFF, "Charging switch", VariableDatatype::DT_BOOL, VariableUOM::UOM_UNDEFINED, VariableSource::SR_REALTIME, VariableMode::MD_READWRITE, vPIN_CHARGE_DEVICE_ENABLED_DF, MQTT_TOPIC_CHARGE_DEVICE_ENABLED_DF);
-    this->initializeVariable(Variable::HEATSINK_TEMP, "Heatsink temp.", VariableDatatype::DT_FLOAT, VariableUOM::UOM_TEMPERATURE_C, VariableSource::SR_REALTIME, VariableMode::MD_READ, vPIN_CONTROLLER_HEATSINK_TEMP_DF, MQTT_TOPIC_CONTROLLER_HEATSINK_TEMP_DF);
-    this->initializeVariable(Variable::INTERNAL_STATUS, "Internal status", VariableDatatype::DT_UINT16, VariableUOM::UOM_UNDEFINED, VariableSource::SR_INTERNAL, VariableMode::MD_READ, vPIN_INTERNAL_STATUS_DF, MQTT_TOPIC_INTERNAL_STATUS_DF);
-    this->initializeVariable(Variable::INTERNAL_DEBUG, "Internal debug", VariableDatatype::DT_STRING, VariableUOM::UOM_UNDEFINED, VariableSource::SR_INTERNAL, VariableMode::MD_READ, vPIN_INTERNAL_DEBUG_TERMINAL_DF, MQTT_TOPIC_INTERNAL_DEBUG_TERMINAL_DF);
-    this->initializeVariable(Variable::UPDATE_ALL_CONTROLLER_DATA, "Full refresh from scc", VariableDatatype::DT_BOOL, VariableUOM::UOM_TRIGGER, VariableSource::SR_INTERNAL, VariableMode::MD_READWRITE, vPIN_UPDATE_ALL_CONTROLLER_DATA_DF, MQTT_TOPIC_UPDATE_ALL_CONTROLLER_DATA_DF);
-    this->initializeVariable(Variable::BATTERY_RATED_VOLTAGE, "Batt. rated volt.", VariableDatatype::DT_UINT16, VariableUOM::UOM_VOLT, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_RATED_VOLTAGE_DF, MQTT_TOPIC_BATTERY_RATED_VOLTAGE_DF);
-    this->initializeVariable(Variable::BATTERY_TYPE, "Batt. type", VariableDatatype::DT_UINT16, VariableUOM::UOM_UNDEFINED, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_TYPE_DF, MQTT_TOPIC_BATTERY_TYPE_DF);
-    this->initializeVariable(Variable::BATTERY_CAPACITY, "Batt. capacity", VariableDatatype::DT_UINT16, VariableUOM::UOM_AMPEREHOUR, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_CAPACITY_DF, MQTT_TOPIC_BATTERY_CAPACITY_DF);
-    this->initializeVariable(Variable::BATTERY_EQUALIZATION_DURATION, "Equalization duration", VariableDatatype::DT_UINT16, VariableUOM::UOM_MINUTE, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_EQUALIZATION_DURATION_DF, MQTT_TOPIC_BATTERY_EQUALIZATION_DURATION_DF);
-    this->initializeVariable(Variable::BATTERY_BOOST_DURATION, "Boost duration", VariableDatatype::DT_UINT16, VariableUOM::UOM_MINUTE, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_BOOST_DURATION_DF, MQTT_TOPIC_BATTERY_BOOST_DURATION_DF);
-    this->initializeVariable(Variable::BATTERY_TEMPERATURE_COMPENSATION_COEFFICIENT, "Batt. temp. compensation coeff.", VariableDatatype::DT_FLOAT, VariableUOM::UOM_UNDEFINED, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_TEMPERATURE_COMPENSATION_COEFF_DF, MQTT_TOPIC_BATTERY_TEMPERATURE_COMPENSATION_COEFF_DF);
-    this->initializeVariable(Variable::BATTERY_MANAGEMENT_MODE, "Batt. management mode", VariableDatatype::DT_UINT16, VariableUOM::UOM_UNDEFINED, VariableSource::SR_STATS, VariableMode::MD_READWRITE, vPIN_BATTERY_MANAGEMENT_MODE_DF, MQTT_TOPIC_BATTERY_MANAGEMENT_MODE_DF);
+/**
+ * Definition of all the variables, read in place from flash
+ */
+static const VariableDefinition variableDefinitions[Variable::VARIABLES_COUNT] PROGMEM = {
+#define _VARIABLE_DEFINITION(variable, text, datatype, uom, source, mode, blynkVPin, mqttTopic) \
+    {Variable::variable, text, VariableDatatype::datatype, VariableUOM::uom, VariableSource::source, VariableMode::mode, blynkVPin, mqttTopic},
+    VARIABLE_DEFINITION_LIST(_VARIABLE_DEFINITION)
+#undef _VARIABLE_DEFINITION
+};
+
+// the table is indexed by variable: the list must follow the enum order
+static constexpr Variable variableDefinitionOrder[] = {
+#define _VARIABLE_ORDER(variable, text, datatype, uom, source, mode, blynkVPin, mqttTopic) Variable::variable,
+    VARIABLE_DEFINITION_LIST(_VARIABLE_ORDER)
+#undef _VARIABLE_ORDER
+};
+
+static constexpr bool isVariableDefinitionOrderValid(uint8_t index) {
+    return index >= Variable::VARIABLES_COUNT || (variableDefinitionOrder[index] == index && isVariableDefinitionOrderValid(index + 1));
+}
+
+static_assert(sizeof(variableDefinitionOrder) / sizeof(Variable) == Variable::VARIABLES_COUNT && isVariableDefinitionOrderValid(0), "VARIABLE_DEFINITION_LIST must follow the order of the Variable enum");
+
+// Blynk virtual pins, indexed by variable
+static constexpr int32_t variableBlynkVPins[] = {
+#define _VARIABLE_BLYNK_VPIN(variable, text, datatype, uom, source, mode, blynkVPin, mqttTopic) blynkVPin,
+    VARIABLE_DEFINITION_LIST(_VARIABLE_BLYNK_VPIN)
+#undef _VARIABLE_BLYNK_VPIN
+};
+
+static constexpr bool areBlynkVPinsValid(uint8_t index) {
+    return index >= Variable::VARIABLES_COUNT || (variableBlynkVPins[index] >= VARIABLE_NO_BLYNK_VPIN && variableBlynkVPins[index] <= BLYNK_VPIN_MAX && areBlynkVPinsValid(index + 1));
+}
+
+static_assert(areBlynkVPinsValid(0), "Blynk virtual pins must be within 0 - BLYNK_VPIN_MAX");
+
+// a pin shared by more variables (ie. battery temperatures) is bound to the first one
+static constexpr uint8_t getVariableByBlynkVPin(int32_t pin, uint8_t index) {
+    return index >= Variable::VARIABLES_COUNT || variableBlynkVPins[index] == pin ? index : getVariableByBlynkVPin(pin, index + 1);
+}
+
+/**
+ * Variable bound to each Blynk virtual pin (VARIABLES_COUNT when none), generated at compile time
+ */
+#define _BLYNK_VPIN_LOOKUP_4(pin) getVariableByBlynkVPin(pin, 0), getVariableByBlynkVPin(pin + 1, 0), getVariableByBlynkVPin(pin + 2, 0), getVariableByBlynkVPin(pin + 3, 0),
+#define _BLYNK_VPIN_LOOKUP_16(pin) _BLYNK_VPIN_LOOKUP_4(pin) _BLYNK_VPIN_LOOKUP_4(pin + 4) _BLYNK_VPIN_LOOKUP_4(pin + 8) _BLYNK_VPIN_LOOKUP_4(pin + 12)
+#define _BLYNK_VPIN_LOOKUP_64(pin) _BLYNK_VPIN_LOOKUP_16(pin) _BLYNK_VPIN_LOOKUP_16(pin + 16) _BLYNK_VPIN_LOOKUP_16(pin + 32) _BLYNK_VPIN_LOOKUP_16(pin + 48)
+static constexpr uint8_t blynkVPinVariables[BLYNK_VPIN_MAX + 1] = {
+    _BLYNK_VPIN_LOOKUP_64(0) _BLYNK_VPIN_LOOKUP_64(64) _BLYNK_VPIN_LOOKUP_64(128) _BLYNK_VPIN_LOOKUP_64(192)};
+#undef _BLYNK_VPIN_LOOKUP_64
+#undef _BLYNK_VPIN_LOOKUP_16
+#undef _BLYNK_VPIN_LOOKUP_4
+
+// MQTT topics, indexed by variable
+static constexpr const char *variableMqttTopics[] = {
+#define _VARIABLE_MQTT_TOPIC(variable, text, datatype, uom, source, mode, blynkVPin, mqttTopic) mqttTopic,
+    VARIABLE_DEFINITION_LIST(_VARIABLE_MQTT_TOPIC)
+#undef _VARIABLE_MQTT_TOPIC
+};
+
+static constexpr bool isMqttTopicInRoot(const char *topic, const char *root) {
+    return *root == '\0' || (*topic == *root && isMqttTopicInRoot(topic + 1, root + 1));
+}
+
+static constexpr bool areMqttTopicsInRoot(uint8_t index) {
+    return index >= Variable::VARIABLES_COUNT || ((variableMqttTopics[index] == nullptr || isMqttTopicInRoot(variableMqttTopics[index], MQTT_TOPIC_ROOT)) && areMqttTopicsInRoot(index + 1));
+}
+
+static_assert(areMqttTopicsInRoot(0), "MQTT topics must start with MQTT_TOPIC_ROOT");
+
+/**
+ * Hash (FNV-1a) of the topic without MQTT_TOPIC_ROOT
+ */
+#define MQTT_TOPIC_HASH_SEED 2166136261u
+static constexpr uint32_t getMqttTopicHash(const char *suffix, uint32_t hash) {
+    return *suffix == '\0' ? hash : getMqttTopicHash(suffix + 1, (hash ^ (uint8_t)*suffix) * 16777619u);
+}
+
+// bucket of each variable (MQTT_TOPIC_BUCKETS when there is no topic)
+static constexpr uint8_t variableMqttBuckets[] = {
+#define _VARIABLE_MQTT_BUCKET(variable, text, datatype, uom, source, mode, blynkVPin, mqttTopic) \
+    variableMqttTopics[Variable::variable] == nullptr ? MQTT_TOPIC_BUCKETS : getMqttTopicHash(variableMqttTopics[Variable::variable] + MQTT_TOPIC_ROOT_LENGTH, MQTT_TOPIC_HASH_SEED) % MQTT_TOPIC_BUCKETS,
+    VARIABLE_DEFINITION_LIST(_VARIABLE_MQTT_BUCKET)
+#undef _VARIABLE_MQTT_BUCKET
+};
+
+static constexpr uint8_t getFirstInMqttBucket(uint8_t bucket, uint8_t index) {
+    return index >= Variable::VARIABLES_COUNT || variableMqttBuckets[index] == bucket ? index : getFirstInMqttBucket(bucket, index + 1);
+}
+
+/**
+ * Hash table of the MQTT topics generated at compile time: first variable of each bucket
+ * and next variable in the same bucket (VARIABLES_COUNT at the end of the chain)
+ */
+#define _MQTT_BUCKET_HEADS_4(bucket) getFirstInMqttBucket(bucket, 0), getFirstInMqttBucket(bucket + 1, 0), getFirstInMqttBucket(bucket + 2, 0), getFirstInMqttBucket(bucket + 3, 0),
+#define _MQTT_BUCKET_HEADS_16(bucket) _MQTT_BUCKET_HEADS_4(bucket) _MQTT_BUCKET_HEADS_4(bucket + 4) _MQTT_BUCKET_HEADS_4(bucket + 8) _MQTT_BUCKET_HEADS_4(bucket + 12)
+static constexpr uint8_t mqttTopicBucketHeads[MQTT_TOPIC_BUCKETS] = {
+    _MQTT_BUCKET_HEADS_16(0) _MQTT_BUCKET_HEADS_16(16) _MQTT_BUCKET_HEADS_16(32) _MQTT_BUCKET_HEADS_16(48)};
+#undef _MQTT_BUCKET_HEADS_16
+#undef _MQTT_BUCKET_HEADS_4
+
+static constexpr uint8_t mqttTopicBucketNext[Variable::VARIABLES_COUNT] = {
+#define _MQTT_BUCKET_NEXT(variable, text, datatype, uom, source, mode, blynkVPin, mqttTopic) getFirstInMqttBucket(variableMqttBuckets[Variable::variable], Variable::variable + 1),
+    VARIABLE_DEFINITION_LIST(_MQTT_BUCKET_NEXT)
+#undef _MQTT_BUCKET_NEXT
+};
+
+static constexpr DerivedVariableDefinition derivedVariables[DERIVED_VARIABLES_COUNT] = {
+#define _DERIVED_VARIABLE_DEFINITION(variable, operation, operand1, operand2) \
+    {Variable::variable, DerivedOperation::operation, Variable::operand1, Variable::operand2},
+    DERIVED_VARIABLE_LIST(_DERIVED_VARIABLE_DEFINITION)
+#undef _DERIVED_VARIABLE_DEFINITION
+};
+
+static constexpr bool isDerivedVariable(Variable variable, uint8_t index) {
+    return index < DERIVED_VARIABLES_COUNT && (derivedVariables[index].variable == variable || isDerivedVariable(variable, index + 1));
+}
+
+static constexpr bool derivedFlags[Variable::VARIABLES_COUNT] = {
+#define _DERIVED_FLAG(variable, text, datatype, uom, source, mode, blynkVPin, mqttTopic) isDerivedVariable(Variable::variable, 0),
+    VARIABLE_DEFINITION_LIST(_DERIVED_FLAG)
+#undef _DERIVED_FLAG
+};
+
+static constexpr uint8_t getDerivedDependantsOf(Variable variable, uint8_t index) {
+    return index >= DERIVED_VARIABLES_COUNT ? 0 : ((derivedVariables[index].operand1 == variable || derivedVariables[index].operand2 == variable) ? 1 << index : 0) | getDerivedDependantsOf(variable, index + 1);
+}
+
+static constexpr uint8_t derivedDependants[Variable::VARIABLES_COUNT] = {
+#define _DERIVED_DEPENDANTS(variable, text, datatype, uom, source, mode, blynkVPin, mqttTopic) getDerivedDependantsOf(Variable::variable, 0),
+    VARIABLE_DEFINITION_LIST(_DERIVED_DEPENDANTS)
+#undef _DERIVED_DEPENDANTS
+};
+
+static constexpr VariableFilterDefinition variableFilters[FILTERED_VARIABLES_COUNT] = {
+#define _VARIABLE_FILTER_DEFINITION(variable, filter, parameter) \
+    {Variable::variable, VariableFilterType::filter, parameter},
+    VARIABLE_FILTER_LIST(_VARIABLE_FILTER_DEFINITION)
+#undef _VARIABLE_FILTER_DEFINITION
+};
+
+static constexpr VariablePublishPolicy getDefaultPublishPolicy(Variable variable) {
+#define _PUBLISH_POLICY_DEFAULT(policyVariable, deadbandType, deadband, minInterval, maxAge) \
+    variable == Variable::policyVariable ? VariablePublishPolicy{deadband, minInterval, maxAge, VariableDeadbandType::deadbandType} :
+    return VARIABLE_PUBLISH_POLICY_LIST(_PUBLISH_POLICY_DEFAULT) VariablePublishPolicy{0, 0, 0, VariableDeadbandType::DB_NONE};
+#undef _PUBLISH_POLICY_DEFAULT
 }
 
+/**
+ * Publish policies, in RAM as they can be changed at runtime (statically initialized)
+ */
+static VariablePublishPolicy publishPolicies[Variable::VARIABLES_COUNT] = {
+#define _PUBLISH_POLICY_INITIALIZE(variable, text, datatype, uom, source, mode, blynkVPin, mqttTopic) getDefaultPublishPolicy(Variable::variable),
+    VARIABLE_DEFINITION_LIST(_PUBLISH_POLICY_INITIALIZE)
+#undef _PUBLISH_POLICY_INITIALIZE
+};
+
 const VariableDefinition *VariableDefiner::getDefinitionByBlynkVPin(uint8_t pin) {
-    for (uint8_t index = 0; index < Variable::VARIABLES_COUNT; index++) {
-        if (variables[index].blynkVPin != nullptr && *(variables[index].blynkVPin) == pin) {
-            return &(variables[index]);
-        }
-    }
-    return nullptr;
+    uint8_t variable = blynkVPinVariables[pin];
+    return variable < Variable::VARIABLES_COUNT ? &(variableDefinitions[variable]) : nullptr;
 }
 
 const VariableDefinition *VariableDefiner::getDefinitionByMqttTopic(const char *topic) {
-    for (uint8_t index = 0; index < Variable::VARIABLES_COUNT; index++) {
-        if (variables[index].mqttTopic != nullptr && strcmp(variables[index].mqttTopic, topic) == 0) {
-            return &(variables[index]);
+    if (strncmp(topic, MQTT_TOPIC_ROOT, MQTT_TOPIC_ROOT_LENGTH) != 0) {
+        return nullptr;
+    }
+    topic += MQTT_TOPIC_ROOT_LENGTH;
+    for (uint8_t index = mqttTopicBucketHeads[getMqttTopicHash(topic, MQTT_TOPIC_HASH_SEED) % MQTT_TOPIC_BUCKETS]; index < Variable::VARIABLES_COUNT; index = mqttTopicBucketNext[index]) {
+        if (strcmp(variableDefinitions[index].mqttTopic + MQTT_TOPIC_ROOT_LENGTH, topic) == 0) {
+            return &(variableDefinitions[index]);
         }
     }
     return nullptr;
 }
 
-void VariableDefiner::initializeVariable(Variable variable, const char *text, VariableDatatype datatype, VariableUOM uom, VariableSource source, VariableMode mode, uint8_t *blynkPin, const char *mqttTopic) {
-    variables[variable] = {variable, text, datatype, uom, source, mode, blynkPin, mqttTopic};
+static const char *const variableNames[Variable::VARIABLES_COUNT] = {
+#define _VARIABLE_NAME(variable, text, datatype, uom, source, mode, blynkVPin, mqttTopic) #variable,
+    VARIABLE_DEFINITION_LIST(_VARIABLE_NAME)
+#undef _VARIABLE_NAME
+};
+
+Variable VariableDefiner::getVariableByName(const char *name) {
+    uint8_t index = 0;
+    while (index < Variable::VARIABLES_COUNT && strcmp(variableNames[index], name) != 0) {
+        index++;
+    }
+    return (Variable)index;
 }
 
 const VariableDefinition *VariableDefiner::getDefinition(Variable variable) {
-    return &(variables[variable]);
+    return &(variableDefinitions[variable]);
 }
 
 VariableDatatype VariableDefiner::getDatatype(Variable variable) {
-    return variables[variable].datatype;
+    return variableDefinitions[variable].datatype;
+}
+
+bool VariableDefiner::isFromScc(const Variable variable) {
+    return variableDefinitions[variable].source != VariableSource::SR_INTERNAL;
+}
+
+const VariableFilterDefinition *VariableDefiner::getFilterDefinition(uint8_t index) {
+    return &(variableFilters[index]);
+}
+
+const VariablePublishPolicy *VariableDefiner::getPublishPolicy(Variable variable) {
+    return &(publishPolicies[variable]);
+}
+
+void VariableDefiner::setPublishPolicy(Variable variable, VariableDeadbandType deadbandType, float deadband, uint16_t minInterval, uint16_t maxAge) {
+    publishPolicies[variable] = {deadband, minInterval, maxAge, deadbandType};
+}
+
+uint8_t VariableDefiner::setPublishPolicies(const char *config) {
+    uint8_t count = 0;
+    char name[32];
+    while (config != nullptr && *config != '\0') {
+        while (*config == ' ') {
+            config++;
+        }
+        const char *end = strchr(config, ',');
+        size_t length = end != nullptr ? end - config : strlen(config);
+        const char *separator = (const char *)memchr(config, ':', length);
+        bool valid = false;
+        if (separator != nullptr && separator - config < (int)sizeof(name)) {
+            snprintf(name, sizeof(name), "%.*s", (int)(separator - config), config);
+            Variable variable = this->getVariableByName(name);
+            char *next;
+            float deadband = strtof(separator + 1, &next);
+            VariableDeadbandType deadbandType = VariableDeadbandType::DB_ABSOLUTE;
+            if (*next == '%') {
+                deadbandType = VariableDeadbandType::DB_PERCENT;
+                next++;
+            }
+            uint16_t minInterval = *next == ':' ? strtoul(next + 1, &next, 10) : 0;
+            uint16_t maxAge = *next == ':' ? strtoul(next + 1, &next, 10) : 0;
+            valid = variable < Variable::VARIABLES_COUNT && next == config + length;
+            if (valid) {
+                this->setPublishPolicy(variable, deadband > 0 ? deadbandType : VariableDeadbandType::DB_NONE, deadband, minInterval, maxAge);
+                count++;
+            }
+        }
+        if (!valid && length > 0) {
+            debugPrintf(true, "ERROR: invalid publish policy \"%.*s\"", (int)length, config);
+        }
+        config = end != nullptr ? end + 1 : nullptr;
+    }
+    return count;
+}
+
+bool VariableDefiner::isWithinDeadband(Variable variable, float lastValue, float value) {
+    const VariablePublishPolicy *policy = &(publishPolicies[variable]);
+    float delta = value > lastValue ? value - lastValue : lastValue - value;
+    switch (policy->deadbandType) {
+        case VariableDeadbandType::DB_ABSOLUTE:
+            return delta < policy->deadband;
+        case VariableDeadbandType::DB_PERCENT:
+            return delta < (lastValue > 0 ? lastValue : -lastValue) * policy->deadband / 100;
+        default:
+            return false;
+    }
+}
+
+const DerivedVariableDefinition *VariableDefiner::getDerivedDefinition(uint8_t index) {
+    return &(derivedVariables[index]);
+}
+
+bool VariableDefiner::isDerived(Variable variable) {
+    return derivedFlags[variable];
+}
+
+uint8_t VariableDefiner::getDerivedDependants(Variable variable) {
+    return derivedDependants[variable];
+}
+
+VariableSyncPriority VariableDefiner::getSyncPriority(Variable variable) {
+    const VariableDefinition *def = &(variableDefinitions[variable]);
+    switch (def->source) {
+        case VariableSource::SR_REALTIME:
+            return def->datatype == VariableDatatype::DT_BOOL || def->datatype == VariableDatatype::DT_STRING ? VariableSyncPriority::SP_ALARM : VariableSyncPriority::SP_REALTIME;
+        case VariableSource::SR_STATS:
+            return def->mode == VariableMode::MD_READWRITE ? VariableSyncPriority::SP_SETTINGS : VariableSyncPriority::SP_STATS;
+        default:
+            return VariableSyncPriority::SP_ALARM;
+    }
 }
 
 uint8_t VariableDefiner::getVariableSize(Variable variable) {
     switch (this->getDatatype(variable)) {
         case VariableDatatype::DT_BOOL:
-            return sizeof(bool);
+            return VariableDatatypeInfo<VariableDatatype::DT_BOOL>::size;
         case VariableDatatype::DT_FLOAT:
-            return sizeof(float);
+            return VariableDatatypeInfo<VariableDatatype::DT_FLOAT>::size;
         case VariableDatatype::DT_UINT16:
-            return sizeof(uint16_t);
+            return VariableDatatypeInfo<VariableDatatype::DT_UINT16>::size;
         case VariableDatatype::DT_STRING:
-            return 20;
+            return VariableDatatypeInfo<VariableDatatype::DT_STRING>::size;
     }
     return 0;
 }
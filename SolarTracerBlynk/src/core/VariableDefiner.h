@@ -27,6 +27,7 @@
 #include "../incl/include_all_blynk_vpin.h"
 #include "../incl/include_all_core.h"
 #include "../incl/include_all_mqtt_topic.h"
+#include "variable_definitions.h"
 
 typedef enum {
     SR_REALTIME,
@@ -114,6 +115,21 @@ typedef enum {
     CONSUMED_ENERGY_MONTH,
     CONSUMED_ENERGY_YEAR,
     CONSUMED_ENERGY_TOTAL,
+    PV_RATED_POWER,
+    //---------------- derived
+    CHARGING_EFFICIENCY,  // BATTERY_CHARGE_POWER / PV_POWER
+    BATTERY_NET_POWER,    // BATTERY_CHARGE_POWER - LOAD_POWER
+    LOAD_SHARE,           // LOAD_POWER / PV_POWER
+    PV_UTILISATION,       // PV_POWER / PV_RATED_POWER
+    //---------------- rollup (last closed window)
+    PV_POWER_MINUTE_AVG,
+    PV_POWER_HOUR_MAX,
+    PV_ENERGY_HOUR,
+    LOAD_ENERGY_HOUR,
+    BATTERY_VOLTAGE_DAY_MIN,
+    BATTERY_VOLTAGE_DAY_MAX,
+    PV_ENERGY_DAY,
+    LOAD_ENERGY_DAY,
     //----------------
     INTERNAL_STATUS,
     INTERNAL_DEBUG,
@@ -123,6 +139,127 @@ typedef enum {
     VARIABLES_COUNT
 } Variable;
 
+/**
+ * Compile time info about the values of a datatype
+ */
+template <typename T, VariableDatatype D>
+struct VariableScalarDatatypeInfo {
+        typedef T type;
+        static constexpr VariableDatatype datatype = D;
+        static constexpr uint8_t size = sizeof(T);
+
+        static inline T read(const uint8_t *data) {
+            return *(const T *)data;
+        }
+
+        /**
+         * Store the value, return true if it differs from the stored one
+         */
+        static inline bool write(uint8_t *data, T value) {
+            if (memcmp(data, &value, sizeof(T)) == 0) {
+                return false;
+            }
+            memcpy(data, &value, sizeof(T));
+            return true;
+        }
+};
+
+template <VariableDatatype D>
+struct VariableDatatypeInfo {};
+
+template <>
+struct VariableDatatypeInfo<VariableDatatype::DT_FLOAT> : VariableScalarDatatypeInfo<float, VariableDatatype::DT_FLOAT> {};
+
+template <>
+struct VariableDatatypeInfo<VariableDatatype::DT_BOOL> : VariableScalarDatatypeInfo<bool, VariableDatatype::DT_BOOL> {};
+
+template <>
+struct VariableDatatypeInfo<VariableDatatype::DT_UINT16> : VariableScalarDatatypeInfo<uint16_t, VariableDatatype::DT_UINT16> {};
+
+template <>
+struct VariableDatatypeInfo<VariableDatatype::DT_STRING> {
+        typedef const char *type;
+        static constexpr VariableDatatype datatype = VariableDatatype::DT_STRING;
+        // including the terminator
+        static constexpr uint8_t size = 20;
+
+        static inline const char *read(const uint8_t *data) {
+            return (const char *)data;
+        }
+
+        static inline bool write(uint8_t *data, const char *value) {
+            if (strncmp((const char *)data, value, size - 1) == 0) {
+                return false;
+            }
+            strncpy((char *)data, value, size - 1);
+            data[size - 1] = '\0';
+            return true;
+        }
+};
+
+/**
+ * Compile time info about a variable: VariableInfo<Variable::PV_POWER>::type is float
+ */
+template <Variable V>
+struct VariableInfo {};
+
+#define _VARIABLE_INFO(variable, text, datatype, uom, source, mode, blynkVPin, mqttTopic) \
+    template <>                                                                           \
+    struct VariableInfo<Variable::variable> : VariableDatatypeInfo<VariableDatatype::datatype> {};
+VARIABLE_DEFINITION_LIST(_VARIABLE_INFO)
+#undef _VARIABLE_INFO
+
+typedef enum {
+    DB_NONE,
+    DB_ABSOLUTE,
+    DB_PERCENT
+} VariableDeadbandType;
+
+struct VariablePublishPolicy {
+    float deadband;
+    // seconds
+    uint16_t minInterval;
+    // seconds, 0: default of the sync
+    uint16_t maxAge;
+    VariableDeadbandType deadbandType;
+};
+
+/**
+ * Priority of the updates when the sync is rate limited, highest first
+ */
+typedef enum {
+    // switch states, status texts, internal
+    SP_ALARM,
+    SP_REALTIME,
+    SP_STATS,
+    // writable stats
+    SP_SETTINGS,
+    SP_COUNT
+} VariableSyncPriority;
+
+typedef enum {
+    FT_EMA,
+    FT_MEDIAN
+} VariableFilterType;
+
+struct VariableFilterDefinition {
+    Variable variable;
+    VariableFilterType type;
+    uint8_t parameter;
+};
+
+// variable without a Blynk virtual pin
+#define VARIABLE_NO_BLYNK_VPIN -1
+// highest Blynk virtual pin
+#define BLYNK_VPIN_MAX 255
+// buckets of the MQTT topic hash table
+#define MQTT_TOPIC_BUCKETS 64
+#define MQTT_TOPIC_ROOT_LENGTH (sizeof(MQTT_TOPIC_ROOT) - 1)
+
+/**
+ * Definition of a variable, the table is generated at compile time from VARIABLE_DEFINITION_LIST.
+ * All the fields are 32 bits wide, so that on ESP8266 the table can be read in place from flash.
+ */
 struct VariableDefinition {
     Variable variable;
     const char *text;
@@ -130,10 +267,51 @@ struct VariableDefinition {
     VariableUOM uom;
     VariableSource source;
     VariableMode mode;
-    const uint8_t *blynkVPin;
+    int32_t blynkVPin;
     const char *mqttTopic;
 };
 
+typedef enum {
+    DO_DIFFERENCE,     // operand1 - operand2
+    DO_RATIO_PERCENT   // operand1 / operand2 * 100, 0 when operand2 is not positive
+} DerivedOperation;
+
+struct DerivedVariableDefinition {
+    Variable variable;
+    DerivedOperation operation;
+    Variable operand1;
+    Variable operand2;
+};
+
+#define _DERIVED_VARIABLE_COUNT(variable, operation, operand1, operand2) +1
+#define DERIVED_VARIABLES_COUNT (0 DERIVED_VARIABLE_LIST(_DERIVED_VARIABLE_COUNT))
+
+// dependants of a variable are stored as a bitmask
+static_assert(DERIVED_VARIABLES_COUNT <= 8, "Too many derived variables");
+
+#define _DERIVED_VARIABLE_CHECK(variable, operation, operand1, operand2)                                                              \
+    static_assert(VariableInfo<Variable::variable>::datatype == VariableDatatype::DT_FLOAT &&                                        \
+                      VariableInfo<Variable::operand1>::datatype == VariableDatatype::DT_FLOAT &&                                    \
+                      VariableInfo<Variable::operand2>::datatype == VariableDatatype::DT_FLOAT,                                      \
+                  "Derived variables and their operands must be float");
+DERIVED_VARIABLE_LIST(_DERIVED_VARIABLE_CHECK)
+#undef _DERIVED_VARIABLE_CHECK
+
+#define _VARIABLE_FILTER_COUNT(variable, filter, parameter) +1
+#define FILTERED_VARIABLES_COUNT (0 VARIABLE_FILTER_LIST(_VARIABLE_FILTER_COUNT))
+
+// samples kept by a median filter
+#define VARIABLE_FILTER_MAX_WINDOW 5
+
+#define _VARIABLE_FILTER_CHECK(variable, filter, parameter)                                                                    \
+    static_assert(VariableInfo<Variable::variable>::datatype == VariableDatatype::DT_FLOAT, "Filtered variables must be float"); \
+    static_assert(VariableFilterType::filter != VariableFilterType::FT_MEDIAN || (parameter <= VARIABLE_FILTER_MAX_WINDOW && parameter % 2 == 1), "Invalid median window");
+VARIABLE_FILTER_LIST(_VARIABLE_FILTER_CHECK)
+#undef _VARIABLE_FILTER_CHECK
+
+/**
+ * Access to the variable definitions, all the tables are built at compile time (no heap, no work at boot)
+ */
 class VariableDefiner {
    public:
     static VariableDefiner &getInstance() {
@@ -143,32 +321,62 @@ class VariableDefiner {
 
     const VariableDefinition *getDefinition(Variable variable);
 
+    /**
+     * Variable bound to the Blynk virtual pin (nullptr if none), a single table lookup
+     */
     const VariableDefinition *getDefinitionByBlynkVPin(uint8_t pin);
 
+    /**
+     * Variable bound to the MQTT topic (nullptr if none), looked up by hash of the topic without MQTT_TOPIC_ROOT
+     */
     const VariableDefinition *getDefinitionByMqttTopic(const char *mqttTopic);
 
+    /**
+     * Variable named as in VARIABLE_DEFINITION_LIST (VARIABLES_COUNT if none), linear search for configuration only
+     */
+    Variable getVariableByName(const char *name);
+
     VariableDatatype getDatatype(Variable variable);
 
-    bool isFromScc(const Variable variable) {
-        return this->variables[variable].source != VariableSource::SR_INTERNAL;
-    }
+    bool isFromScc(const Variable variable);
 
-    bool isValueEqual(Variable variable, const void *val1, const void *val2) {
-        uint8_t valueSize = this->getVariableSize(variable);
-        if (valueSize > 0) {
-            return memcmp(val1, val2, valueSize) == 0;
-        }
-        return false;
-    }
+    const VariableFilterDefinition *getFilterDefinition(uint8_t index);
+
+    const VariablePublishPolicy *getPublishPolicy(Variable variable);
+
+    /**
+     * Override the publish policy defined in VARIABLE_PUBLISH_POLICY_LIST
+     */
+    void setPublishPolicy(Variable variable, VariableDeadbandType deadbandType, float deadband, uint16_t minInterval = 0, uint16_t maxAge = 0);
+
+    /**
+     * Override the publish policies from a configuration text (see PUBLISH_POLICY), return the number of policies set
+     */
+    uint8_t setPublishPolicies(const char *config);
+
+    /**
+     * Check if the change from the last published value is too small to be published
+     */
+    bool isWithinDeadband(Variable variable, float lastValue, float value);
 
     uint8_t getVariableSize(Variable variable);
 
-   private:
-    VariableDefiner();
+    VariableSyncPriority getSyncPriority(Variable variable);
 
-    void initializeVariable(Variable variable, const char *text, VariableDatatype datatype, VariableUOM uom, VariableSource source, VariableMode mode, uint8_t *blynkPin, const char *mqttTopic);
+    const DerivedVariableDefinition *getDerivedDefinition(uint8_t index);
 
-    VariableDefinition *variables = new VariableDefinition[Variable::VARIABLES_COUNT]();
+    /**
+     * Check if the variable is computed by the tracer from DERIVED_VARIABLE_LIST, a table lookup
+     */
+    bool isDerived(Variable variable);
+
+    /**
+     * Derived variables (bitmask of indexes) to recompute when the variable changes
+     */
+    uint8_t getDerivedDependants(Variable variable);
+
+   private:
+    VariableDefiner() {}
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,169 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#ifndef VARIABLE_DEFINITIONS_H
+#define VARIABLE_DEFINITIONS_H
+
+/**
+ * Definition of all the variables, in the same order of the Variable enum:
+ *
+ * _(variable, text, datatype, uom, source, mode, blynkVPin, mqttTopic)
+ */
+#define VARIABLE_DEFINITION_LIST(_) \
+    _(PV_VOLTAGE, "PV volt.", DT_FLOAT, UOM_VOLT, SR_REALTIME, MD_READ, vPIN_PV_VOLTAGE_DF, MQTT_TOPIC_PV_VOLTAGE_DF) \
+    _(PV_POWER, "PV power", DT_FLOAT, UOM_WATT, SR_REALTIME, MD_READ, vPIN_PV_POWER_DF, MQTT_TOPIC_PV_POWER_DF) \
+    _(PV_CURRENT, "PV current", DT_FLOAT, UOM_AMPERE, SR_REALTIME, MD_READ, vPIN_PV_CURRENT_DF, MQTT_TOPIC_PV_CURRENT_DF) \
+    _(LOAD_CURRENT, "Load current", DT_FLOAT, UOM_AMPERE, SR_REALTIME, MD_READ, vPIN_LOAD_CURRENT_DF, MQTT_TOPIC_LOAD_CURRENT_DF) \
+    _(LOAD_POWER, "Load power", DT_FLOAT, UOM_WATT, SR_REALTIME, MD_READ, vPIN_LOAD_POWER_DF, MQTT_TOPIC_LOAD_POWER_DF) \
+    _(BATTERY_TEMP, "Batt. temp", DT_FLOAT, UOM_TEMPERATURE_C, SR_REALTIME, MD_READ, vPIN_BATT_TEMP_DF, MQTT_TOPIC_BATT_TEMP_DF) \
+    _(BATTERY_VOLTAGE, "Batt. volt.", DT_FLOAT, UOM_VOLT, SR_REALTIME, MD_READ, vPIN_BATT_VOLTAGE_DF, MQTT_TOPIC_BATT_VOLTAGE_DF) \
+    _(BATTERY_SOC, "Batt. SOC", DT_FLOAT, UOM_PERCENT, SR_REALTIME, MD_READ, vPIN_BATT_REMAIN_DF, MQTT_TOPIC_BATT_REMAIN_DF) \
+    _(CONTROLLER_TEMP, "Controller temp.", DT_FLOAT, UOM_TEMPERATURE_C, SR_REALTIME, MD_READ, vPIN_CONTROLLER_TEMP_DF, MQTT_TOPIC_CONTROLLER_TEMP_DF) \
+    _(BATTERY_CHARGE_CURRENT, "Charging current", DT_FLOAT, UOM_AMPERE, SR_REALTIME, MD_READ, vPIN_BATTERY_CHARGE_CURRENT_DF, MQTT_TOPIC_BATTERY_CHARGE_CURRENT_DF) \
+    _(BATTERY_CHARGE_POWER, "Charging power", DT_FLOAT, UOM_WATT, SR_REALTIME, MD_READ, vPIN_BATTERY_CHARGE_POWER_DF, MQTT_TOPIC_BATTERY_CHARGE_POWER_DF) \
+    _(BATTERY_OVERALL_CURRENT, "Overall current", DT_FLOAT, UOM_AMPERE, SR_REALTIME, MD_READ, vPIN_BATTERY_OVERALL_CURRENT_DF, MQTT_TOPIC_BATTERY_OVERALL_CURRENT_DF) \
+    _(REALTIME_CLOCK, "Date and time", DT_FLOAT, UOM_UNDEFINED, SR_INTERNAL, MD_READWRITE, vPIN_UPDATE_CONTROLLER_DATETIME_DF, MQTT_TOPIC_UPDATE_CONTROLLER_DATETIME_DF) \
+    _(LOAD_FORCE_ONOFF, "Load force switch", DT_BOOL, UOM_UNDEFINED, SR_REALTIME, MD_READ, VARIABLE_NO_BLYNK_VPIN, nullptr) \
+    _(LOAD_MANUAL_ONOFF, "Load switch", DT_BOOL, UOM_UNDEFINED, SR_REALTIME, MD_READWRITE, vPIN_LOAD_ENABLED_DF, MQTT_TOPIC_LOAD_ENABLED_DF) \
+    _(REMOTE_BATTERY_TEMP, "Remote batt. temp.", DT_FLOAT, UOM_TEMPERATURE_C, SR_REALTIME, MD_READ, vPIN_BATT_TEMP_DF, MQTT_TOPIC_BATT_TEMP_DF) \
+    _(GENERATED_ENERGY_TODAY, "Energy generated today", DT_FLOAT, UOM_KILOWATTHOUR, SR_STATS, MD_READ, vPIN_STAT_ENERGY_GENERATED_TODAY_DF, MQTT_TOPIC_STAT_ENERGY_GENERATED_TODAY_DF) \
+    _(GENERATED_ENERGY_MONTH, "Energy generated month", DT_FLOAT, UOM_KILOWATTHOUR, SR_STATS, MD_READ, vPIN_STAT_ENERGY_GENERATED_THIS_MONTH_DF, MQTT_TOPIC_STAT_ENERGY_GENERATED_THIS_MONTH_DF) \
+    _(GENERATED_ENERGY_YEAR, "Energy generated year", DT_FLOAT, UOM_KILOWATTHOUR, SR_STATS, MD_READ, vPIN_STAT_ENERGY_GENERATED_THIS_YEAR_DF, MQTT_TOPIC_STAT_ENERGY_GENERATED_THIS_YEAR_DF) \
+    _(GENERATED_ENERGY_TOTAL, "Energy generated", DT_FLOAT, UOM_KILOWATTHOUR, SR_STATS, MD_READ, vPIN_STAT_ENERGY_GENERATED_TOTAL_DF, MQTT_TOPIC_STAT_ENERGY_GENERATED_TOTAL_DF) \
+    _(MAXIMUM_PV_VOLTAGE_TODAY, "Today PV max. volt.", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READ, vPIN_MAX_PV_VOLTAGE_TODAY_DF, MQTT_TOPIC_MAX_PV_VOLTAGE_TODAY_DF) \
+    _(MINIMUM_PV_VOLTAGE_TODAY, "Today PV min. volt.", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READ, vPIN_MIN_PV_VOLTAGE_TODAY_DF, MQTT_TOPIC_MIN_PV_VOLTAGE_TODAY_DF) \
+    _(MAXIMUM_BATTERY_VOLTAGE_TODAY, "Today batt. max. volt.", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READ, vPIN_MAX_BATTERY_VOLTAGE_TODAY_DF, MQTT_TOPIC_MAX_BATTERY_VOLTAGE_TODAY_DF) \
+    _(MINIMUM_BATTERY_VOLTAGE_TODAY, "Today batt. min. volt.", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READ, vPIN_MIN_BATTERY_VOLTAGE_TODAY_DF, MQTT_TOPIC_MIN_BATTERY_VOLTAGE_TODAY_DF) \
+    _(BATTERY_BOOST_VOLTAGE, "Boost volt.", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READWRITE, vPIN_BATTERY_BOOST_VOLTAGE_DF, MQTT_TOPIC_BATTERY_BOOST_VOLTAGE_DF) \
+    _(BATTERY_EQUALIZATION_VOLTAGE, "Equalization volt.", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READWRITE, vPIN_BATTERY_EQUALIZATION_VOLTAGE_DF, MQTT_TOPIC_BATTERY_EQUALIZATION_VOLTAGE_DF) \
+    _(BATTERY_FLOAT_VOLTAGE, "Float volt.", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READWRITE, vPIN_BATTERY_FLOAT_VOLTAGE_DF, MQTT_TOPIC_BATTERY_FLOAT_VOLTAGE_DF) \
+    _(BATTERY_FLOAT_MIN_VOLTAGE, "Float min. volt.", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READWRITE, vPIN_BATTERY_FLOAT_MIN_VOLTAGE_DF, MQTT_TOPIC_BATTERY_FLOAT_MIN_VOLTAGE_DF) \
+    _(BATTERY_CHARGING_LIMIT_VOLTAGE, "Charging volt. limit", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READWRITE, vPIN_BATTERY_CHARGING_LIMIT_VOLTAGE_DF, MQTT_TOPIC_BATTERY_CHARGING_LIMIT_VOLTAGE_DF) \
+    _(BATTERY_DISCHARGING_LIMIT_VOLTAGE, "Discharging volt. limit", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READWRITE, vPIN_BATTERY_DISCHARGING_LIMIT_VOLTAGE_DF, MQTT_TOPIC_BATTERY_DISCHARGING_LIMIT_VOLTAGE_DF) \
+    _(BATTERY_LOW_VOLTAGE_DISCONNECT, "Low volt. disconnect", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READWRITE, vPIN_BATTERY_LOW_VOLTAGE_DISCONNECT_DF, MQTT_TOPIC_BATTERY_LOW_VOLTAGE_DISCONNECT_DF) \
+    _(BATTERY_LOW_VOLTAGE_RECONNECT, "Low volt. reconnect", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READWRITE, vPIN_BATTERY_LOW_VOLTAGE_RECONNECT_DF, MQTT_TOPIC_BATTERY_LOW_VOLTAGE_RECONNECT_DF) \
+    _(BATTERY_OVER_VOLTAGE_DISCONNECT, "Over volt. disconnect", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READWRITE, vPIN_BATTERY_OVER_VOLTAGE_DISCONNECT_DF, MQTT_TOPIC_BATTERY_OVER_VOLTAGE_DISCONNECT_DF) \
+    _(BATTERY_OVER_VOLTAGE_RECONNECT, "Over volt. reconnect", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READWRITE, vPIN_BATTERY_OVER_VOLTAGE_RECONNECT_DF, MQTT_TOPIC_BATTERY_OVER_VOLTAGE_RECONNECT_DF) \
+    _(BATTERY_UNDER_VOLTAGE_SET, "Under volt. alarm set", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READWRITE, vPIN_BATTERY_UNDER_VOLTAGE_SET_DF, MQTT_TOPIC_BATTERY_UNDER_VOLTAGE_SET_DF) \
+    _(BATTERY_UNDER_VOLTAGE_RESET, "Under volt. alarm reset", DT_FLOAT, UOM_VOLT, SR_STATS, MD_READWRITE, vPIN_BATTERY_UNDER_VOLTAGE_RESET_DF, MQTT_TOPIC_BATTERY_UNDER_VOLTAGE_RESET_DF) \
+    _(BATTERY_STATUS_TEXT, "Batt. status", DT_STRING, UOM_UNDEFINED, SR_REALTIME, MD_READ, vPIN_BATTERY_STATUS_TEXT_DF, MQTT_TOPIC_BATTERY_STATUS_TEXT_DF) \
+    _(CHARGING_EQUIPMENT_STATUS_TEXT, "Charging status", DT_STRING, UOM_UNDEFINED, SR_REALTIME, MD_READ, vPIN_CHARGING_EQUIPMENT_STATUS_TEXT_DF, MQTT_TOPIC_CHARGING_EQUIPMENT_STATUS_TEXT_DF) \
+    _(DISCHARGING_EQUIPMENT_STATUS_TEXT, "Discharging status", DT_STRING, UOM_UNDEFINED, SR_REALTIME, MD_READ, vPIN_DISCHARGING_EQUIPMENT_STATUS_TEXT_DF, MQTT_TOPIC_DISCHARGING_EQUIPMENT_STATUS_TEXT_DF) \
+    _(CHARGING_DEVICE_ONOFF, "Charging switch", DT_BOOL, UOM_UNDEFINED, SR_REALTIME, MD_READWRITE, vPIN_CHARGE_DEVICE_ENABLED_DF, MQTT_TOPIC_CHARGE_DEVICE_ENABLED_DF) \
+    _(HEATSINK_TEMP, "Heatsink temp.", DT_FLOAT, UOM_TEMPERATURE_C, SR_REALTIME, MD_READ, vPIN_CONTROLLER_HEATSINK_TEMP_DF, MQTT_TOPIC_CONTROLLER_HEATSINK_TEMP_DF) \
+    _(BATTERY_RATED_VOLTAGE, "Batt. rated volt.", DT_UINT16, UOM_VOLT, SR_STATS, MD_READWRITE, vPIN_BATTERY_RATED_VOLTAGE_DF, MQTT_TOPIC_BATTERY_RATED_VOLTAGE_DF) \
+    _(BATTERY_TYPE, "Batt. type", DT_UINT16, UOM_UNDEFINED, SR_STATS, MD_READWRITE, vPIN_BATTERY_TYPE_DF, MQTT_TOPIC_BATTERY_TYPE_DF) \
+    _(BATTERY_CAPACITY, "Batt. capacity", DT_UINT16, UOM_AMPEREHOUR, SR_STATS, MD_READWRITE, vPIN_BATTERY_CAPACITY_DF, MQTT_TOPIC_BATTERY_CAPACITY_DF) \
+    _(BATTERY_EQUALIZATION_DURATION, "Equalization duration", DT_UINT16, UOM_MINUTE, SR_STATS, MD_READWRITE, vPIN_BATTERY_EQUALIZATION_DURATION_DF, MQTT_TOPIC_BATTERY_EQUALIZATION_DURATION_DF) \
+    _(BATTERY_BOOST_DURATION, "Boost duration", DT_UINT16, UOM_MINUTE, SR_STATS, MD_READWRITE, vPIN_BATTERY_BOOST_DURATION_DF, MQTT_TOPIC_BATTERY_BOOST_DURATION_DF) \
+    _(BATTERY_TEMPERATURE_COMPENSATION_COEFFICIENT, "Batt. temp. compensation coeff.", DT_FLOAT, UOM_UNDEFINED, SR_STATS, MD_READWRITE, vPIN_BATTERY_TEMPERATURE_COMPENSATION_COEFF_DF, MQTT_TOPIC_BATTERY_TEMPERATURE_COMPENSATION_COEFF_DF) \
+    _(BATTERY_MANAGEMENT_MODE, "Batt. management mode", DT_UINT16, UOM_UNDEFINED, SR_STATS, MD_READWRITE, vPIN_BATTERY_MANAGEMENT_MODE_DF, MQTT_TOPIC_BATTERY_MANAGEMENT_MODE_DF) \
+    _(CONSUMED_ENERGY_TODAY, "Energy consumed today", DT_FLOAT, UOM_KILOWATTHOUR, SR_STATS, MD_READ, vPIN_STAT_ENERGY_CONSUMED_TODAY_DF, MQTT_TOPIC_STAT_ENERGY_CONSUMED_TODAY_DF) \
+    _(CONSUMED_ENERGY_MONTH, "Energy consumed month", DT_FLOAT, UOM_KILOWATTHOUR, SR_STATS, MD_READ, vPIN_STAT_ENERGY_CONSUMED_THIS_MONTH_DF, MQTT_TOPIC_STAT_ENERGY_CONSUMED_THIS_MONTH_DF) \
+    _(CONSUMED_ENERGY_YEAR, "Energy consumed year", DT_FLOAT, UOM_KILOWATTHOUR, SR_STATS, MD_READ, vPIN_STAT_ENERGY_CONSUMED_THIS_YEAR_DF, MQTT_TOPIC_STAT_ENERGY_CONSUMED_THIS_YEAR_DF) \
+    _(CONSUMED_ENERGY_TOTAL, "Energy consumed", DT_FLOAT, UOM_KILOWATTHOUR, SR_STATS, MD_READ, vPIN_STAT_ENERGY_CONSUMED_TOTAL_DF, MQTT_TOPIC_STAT_ENERGY_CONSUMED_TOTAL_DF) \
+    _(PV_RATED_POWER, "PV rated power", DT_FLOAT, UOM_WATT, SR_STATS, MD_READ, vPIN_PV_RATED_POWER_DF, MQTT_TOPIC_PV_RATED_POWER_DF) \
+    _(CHARGING_EFFICIENCY, "Charging efficiency", DT_FLOAT, UOM_PERCENT, SR_REALTIME, MD_READ, vPIN_CHARGING_EFFICIENCY_DF, MQTT_TOPIC_CHARGING_EFFICIENCY_DF) \
+    _(BATTERY_NET_POWER, "Batt. net power", DT_FLOAT, UOM_WATT, SR_REALTIME, MD_READ, vPIN_BATTERY_NET_POWER_DF, MQTT_TOPIC_BATTERY_NET_POWER_DF) \
+    _(LOAD_SHARE, "Load share of PV", DT_FLOAT, UOM_PERCENT, SR_REALTIME, MD_READ, vPIN_LOAD_SHARE_DF, MQTT_TOPIC_LOAD_SHARE_DF) \
+    _(PV_UTILISATION, "PV utilisation", DT_FLOAT, UOM_PERCENT, SR_REALTIME, MD_READ, vPIN_PV_UTILISATION_DF, MQTT_TOPIC_PV_UTILISATION_DF) \
+    _(PV_POWER_MINUTE_AVG, "PV power last min avg", DT_FLOAT, UOM_WATT, SR_REALTIME, MD_READ, vPIN_PV_POWER_MINUTE_AVG_DF, MQTT_TOPIC_PV_POWER_MINUTE_AVG_DF) \
+    _(PV_POWER_HOUR_MAX, "PV power last hour max", DT_FLOAT, UOM_WATT, SR_REALTIME, MD_READ, vPIN_PV_POWER_HOUR_MAX_DF, MQTT_TOPIC_PV_POWER_HOUR_MAX_DF) \
+    _(PV_ENERGY_HOUR, "PV energy last hour", DT_FLOAT, UOM_KILOWATTHOUR, SR_REALTIME, MD_READ, vPIN_PV_ENERGY_HOUR_DF, MQTT_TOPIC_PV_ENERGY_HOUR_DF) \
+    _(LOAD_ENERGY_HOUR, "Load energy last hour", DT_FLOAT, UOM_KILOWATTHOUR, SR_REALTIME, MD_READ, vPIN_LOAD_ENERGY_HOUR_DF, MQTT_TOPIC_LOAD_ENERGY_HOUR_DF) \
+    _(BATTERY_VOLTAGE_DAY_MIN, "Batt. volt. last day min", DT_FLOAT, UOM_VOLT, SR_REALTIME, MD_READ, vPIN_BATTERY_VOLTAGE_DAY_MIN_DF, MQTT_TOPIC_BATTERY_VOLTAGE_DAY_MIN_DF) \
+    _(BATTERY_VOLTAGE_DAY_MAX, "Batt. volt. last day max", DT_FLOAT, UOM_VOLT, SR_REALTIME, MD_READ, vPIN_BATTERY_VOLTAGE_DAY_MAX_DF, MQTT_TOPIC_BATTERY_VOLTAGE_DAY_MAX_DF) \
+    _(PV_ENERGY_DAY, "PV energy last day", DT_FLOAT, UOM_KILOWATTHOUR, SR_REALTIME, MD_READ, vPIN_PV_ENERGY_DAY_DF, MQTT_TOPIC_PV_ENERGY_DAY_DF) \
+    _(LOAD_ENERGY_DAY, "Load energy last day", DT_FLOAT, UOM_KILOWATTHOUR, SR_REALTIME, MD_READ, vPIN_LOAD_ENERGY_DAY_DF, MQTT_TOPIC_LOAD_ENERGY_DAY_DF) \
+    _(INTERNAL_STATUS, "Internal status", DT_UINT16, UOM_UNDEFINED, SR_INTERNAL, MD_READ, vPIN_INTERNAL_STATUS_DF, MQTT_TOPIC_INTERNAL_STATUS_DF) \
+    _(INTERNAL_DEBUG, "Internal debug", DT_STRING, UOM_UNDEFINED, SR_INTERNAL, MD_READ, vPIN_INTERNAL_DEBUG_TERMINAL_DF, MQTT_TOPIC_INTERNAL_DEBUG_TERMINAL_DF) \
+    _(UPDATE_ALL_CONTROLLER_DATA, "Full refresh from scc", DT_BOOL, UOM_TRIGGER, SR_INTERNAL, MD_READWRITE, vPIN_UPDATE_ALL_CONTROLLER_DATA_DF, MQTT_TOPIC_UPDATE_ALL_CONTROLLER_DATA_DF)
+
+/**
+ * Variables computed by the tracer from other ones, recomputed only when an operand changes:
+ *
+ * _(variable, operation, operand1, operand2)
+ */
+#define DERIVED_VARIABLE_LIST(_)                                                  \
+    _(CHARGING_EFFICIENCY, DO_RATIO_PERCENT, BATTERY_CHARGE_POWER, PV_POWER)      \
+    _(BATTERY_NET_POWER, DO_DIFFERENCE, BATTERY_CHARGE_POWER, LOAD_POWER)         \
+    _(LOAD_SHARE, DO_RATIO_PERCENT, LOAD_POWER, PV_POWER)                         \
+    _(PV_UTILISATION, DO_RATIO_PERCENT, PV_POWER, PV_RATED_POWER)
+
+/**
+ * Publish policy of the noisy variables (the others are published on any change):
+ * changes smaller than the deadband (absolute or percent of the last value published)
+ * are not published, minInterval is the min number of seconds between 2 publishes,
+ * maxAge is the number of seconds after which an unchanged value is sent again (0: default of the server).
+ *
+ * _(variable, deadbandType, deadband, minInterval, maxAge)
+ */
+#define VARIABLE_PUBLISH_POLICY_LIST(_)                 \
+    _(PV_VOLTAGE, DB_ABSOLUTE, 0.1, 0, 0)               \
+    _(PV_CURRENT, DB_ABSOLUTE, 0.05, 0, 0)              \
+    _(PV_POWER, DB_PERCENT, 1, 0, 0)                    \
+    _(LOAD_CURRENT, DB_ABSOLUTE, 0.05, 0, 0)            \
+    _(LOAD_POWER, DB_PERCENT, 1, 0, 0)                  \
+    _(BATTERY_VOLTAGE, DB_ABSOLUTE, 0.02, 0, 0)         \
+    _(BATTERY_CHARGE_CURRENT, DB_ABSOLUTE, 0.05, 0, 0)  \
+    _(BATTERY_CHARGE_POWER, DB_PERCENT, 1, 0, 0)        \
+    _(BATTERY_OVERALL_CURRENT, DB_ABSOLUTE, 0.05, 0, 0) \
+    _(BATTERY_TEMP, DB_ABSOLUTE, 0.5, 10, 120)          \
+    _(CONTROLLER_TEMP, DB_ABSOLUTE, 0.5, 10, 120)       \
+    _(HEATSINK_TEMP, DB_ABSOLUTE, 0.5, 10, 120)         \
+    _(REMOTE_BATTERY_TEMP, DB_ABSOLUTE, 0.5, 10, 120)   \
+    _(CHARGING_EFFICIENCY, DB_ABSOLUTE, 1, 0, 0)        \
+    _(BATTERY_NET_POWER, DB_PERCENT, 1, 0, 0)           \
+    _(LOAD_SHARE, DB_ABSOLUTE, 1, 0, 0)                 \
+    _(PV_UTILISATION, DB_ABSOLUTE, 1, 0, 0)
+
+/**
+ * Filters applied to the values read before they are stored in the tracer:
+ * FT_EMA exponential moving average (parameter: weight of the new sample, percent),
+ * FT_MEDIAN median of the last samples (parameter: window, odd, max VARIABLE_FILTER_MAX_WINDOW).
+ *
+ * _(variable, filter, parameter)
+ */
+#define VARIABLE_FILTER_LIST(_)              \
+    _(LOAD_CURRENT, FT_MEDIAN, 3)            \
+    _(BATTERY_TEMP, FT_EMA, 30)              \
+    _(CONTROLLER_TEMP, FT_EMA, 30)           \
+    _(HEATSINK_TEMP, FT_EMA, 30)             \
+    _(REMOTE_BATTERY_TEMP, FT_EMA, 30)
+
+/**
+ * Variables set with an aggregate of a realtime variable when a window closes (USE_VARIABLE_ROLLUP):
+ *
+ * _(variable, input, window, aggregate)
+ */
+#define ROLLUP_VARIABLE_LIST(_)                                        \
+    _(PV_POWER_MINUTE_AVG, PV_POWER, RW_MINUTE, RA_MEAN)               \
+    _(PV_POWER_HOUR_MAX, PV_POWER, RW_HOUR, RA_MAX)                    \
+    _(PV_ENERGY_HOUR, PV_POWER, RW_HOUR, RA_ENERGY)                    \
+    _(LOAD_ENERGY_HOUR, LOAD_POWER, RW_HOUR, RA_ENERGY)                \
+    _(BATTERY_VOLTAGE_DAY_MIN, BATTERY_VOLTAGE, RW_DAY, RA_MIN)        \
+    _(BATTERY_VOLTAGE_DAY_MAX, BATTERY_VOLTAGE, RW_DAY, RA_MAX)        \
+    _(PV_ENERGY_DAY, PV_POWER, RW_DAY, RA_ENERGY)                      \
+    _(LOAD_ENERGY_DAY, LOAD_POWER, RW_DAY, RA_ENERGY)
+
+#endif
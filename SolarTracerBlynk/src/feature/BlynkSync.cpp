@@ -30,7 +30,7 @@ void blynkDebugCallback(String message) {
 #endif
 
 BlynkSync::BlynkSync() {
-    this->renewValueCount = BLYNK_VALUE_CACHES_UNTIL_COUNT;
+    this->maxAge = BLYNK_VALUE_MAX_AGE_MS;
 }
 
 void BlynkSync::setup() {
@@ -78,22 +78,22 @@ void BlynkSync::loop() {
 }
 
 bool BlynkSync::sendUpdateToVariable(const VariableDefinition *def, const void *value) {
-    if (def->blynkVPin != nullptr) {
+    if (def->blynkVPin != VARIABLE_NO_BLYNK_VPIN) {
         switch (def->datatype) {
             case VariableDatatype::DT_BOOL: {
-                Blynk.virtualWrite(*def->blynkVPin, *(bool *)value);
+                Blynk.virtualWrite(def->blynkVPin, *(bool *)value);
                 return true;
             } break;
             case VariableDatatype::DT_FLOAT: {
-                Blynk.virtualWrite(*def->blynkVPin, *(float *)value);
+                Blynk.virtualWrite(def->blynkVPin, *(float *)value);
                 return true;
             } break;
             case VariableDatatype::DT_UINT16: {
-                Blynk.virtualWrite(*def->blynkVPin, *(uint16_t *)value);
+                Blynk.virtualWrite(def->blynkVPin, *(uint16_t *)value);
                 return true;
             } break;
             case VariableDatatype::DT_STRING: {
-                Blynk.virtualWrite(*def->blynkVPin, (const char *)value);
+                Blynk.virtualWrite(def->blynkVPin, (const char *)value);
                 return true;
             }
         }
@@ -102,7 +102,7 @@ bool BlynkSync::sendUpdateToVariable(const VariableDefinition *def, const void *
 }
 
 // upload values stats
-void BlynkSync::uploadStatsToBlynk() {
+void BlynkSync::uploadStats() {
     if (!Blynk.connected()) {
         return;
     }
@@ -111,7 +111,7 @@ void BlynkSync::uploadStatsToBlynk() {
 }
 
 // upload values realtime
-void BlynkSync::uploadRealtimeToBlynk() {
+void BlynkSync::uploadRealtime() {
     if (!Blynk.connected()) {
         return;
     }
@@ -123,6 +123,18 @@ void BlynkSync::uploadRealtimeToBlynk() {
     this->sendUpdateAllBySource(VariableSource::SR_REALTIME, false);
 }
 
+#ifdef USE_VARIABLE_RULES
+bool BlynkSync::sendAlarm(const char *message) {
+#ifdef USE_BLYNK_2
+    if (Blynk.connected()) {
+        Blynk.logEvent(BLYNK_ALARM_EVENT, message);
+        return true;
+    }
+#endif
+    return false;
+}
+#endif
+
 BLYNK_WRITE_DEFAULT() {
     const VariableDefinition *def = VariableDefiner::getInstance().getDefinitionByBlynkVPin(request.pin);
     if (def != nullptr) {
@@ -134,17 +146,17 @@ BLYNK_WRITE_DEFAULT() {
                         if (Datetime::getMyNowTm() != nullptr) {
                             Controller::getInstance().getSolarController()->syncRealtimeClock(Datetime::getMyNowTm());
                         }
-                        Blynk.virtualWrite(*def->blynkVPin, 0);
+                        Blynk.virtualWrite(def->blynkVPin, 0);
                     }
                 } break;
                 case Variable::UPDATE_ALL_CONTROLLER_DATA: {
                     if (param.asInt() > 0) {
                         debugPrintln("REQUEST ALL VALUES TO CONTROLLER");
                         Controller::getInstance().getSolarController()->fetchAllValues();
-                        BlynkSync::getInstance().uploadRealtimeToBlynk();
-                        BlynkSync::getInstance().uploadStatsToBlynk();
+                        BlynkSync::getInstance().uploadRealtime();
+                        BlynkSync::getInstance().uploadStats();
 
-                        Blynk.virtualWrite(*def->blynkVPin, 0);
+                        Blynk.virtualWrite(def->blynkVPin, 0);
                     }
                 } break;
             }
@@ -34,7 +34,7 @@
 #include "../incl/include_all_lib.h"
 
 #define BLYNK_CONNECT_ATTEMPT 3
-#define BLYNK_VALUE_CACHES_UNTIL_COUNT 15
+#define BLYNK_VALUE_MAX_AGE_MS 30000L
 
 #ifdef vPIN_INTERNAL_DEBUG_TERMINAL
 void blynkDebugCallback(String message);
@@ -53,16 +53,20 @@ class BlynkSync : public BaseSync {
         inline bool isVariableAllowed(const VariableDefinition *def);
         bool sendUpdateToVariable(const VariableDefinition *def, const void *value);
         // upload values stats
-        void uploadStatsToBlynk();
+        void uploadStats();
         // upload values realtime
-        void uploadRealtimeToBlynk();
+        void uploadRealtime();
+#ifdef USE_VARIABLE_RULES
+        // Blynk 2.0 events only (USE_BLYNK_2), not sent otherwise
+        bool sendAlarm(const char *message);
+#endif
 
     private:
         BlynkSync();
 };
 
 bool BlynkSync::isVariableAllowed(const VariableDefinition *def) {
-    return def->blynkVPin != nullptr;
+    return def->blynkVPin != VARIABLE_NO_BLYNK_VPIN;
 }
 
 #endif
@@ -56,7 +56,7 @@ inline const char *getVariableUOM(VariableUOM uom) {
 
 void onMqttNumberCallback(HANumeric value, HANumber *el) {
     if (!ignoreCallback) {
-        MqttHASync haSync = MqttHASync::getInstance();
+        MqttHASync &haSync = MqttHASync::getInstance();
         Variable var = haSync.findVariableBySensor(el);
         if (var < Variable::VARIABLES_COUNT) {
             switch (VariableDefiner::getInstance().getDatatype(var)) {
@@ -75,7 +75,7 @@ void onMqttNumberCallback(HANumeric value, HANumber *el) {
 
 void onMqttBoolButtonCallback(HAButton *el) {
     if (!ignoreCallback) {
-        MqttHASync haSync = MqttHASync::getInstance();
+        MqttHASync &haSync = MqttHASync::getInstance();
         Variable var = haSync.findVariableBySensor(el);
         if (var < Variable::VARIABLES_COUNT) {
             switch (var) {
@@ -88,8 +88,8 @@ void onMqttBoolButtonCallback(HAButton *el) {
                 case Variable::UPDATE_ALL_CONTROLLER_DATA:
                     debugPrintln("REQUEST ALL VALUES TO CONTROLLER");
                     Controller::getInstance().getSolarController()->fetchAllValues();
-                    MqttHASync::getInstance().uploadRealtimeToMqtt();
-                    MqttHASync::getInstance().uploadStatsToMqtt();
+                    MqttHASync::getInstance().uploadRealtime();
+                    MqttHASync::getInstance().uploadStats();
                     break;
             }
         }
@@ -98,7 +98,7 @@ void onMqttBoolButtonCallback(HAButton *el) {
 
 void onMqttBoolSwitchCallback(bool value, HASwitch *el) {
     if (!ignoreCallback) {
-        MqttHASync haSync = MqttHASync::getInstance();
+        MqttHASync &haSync = MqttHASync::getInstance();
         Variable var = haSync.findVariableBySensor(el);
         if (var < Variable::VARIABLES_COUNT) {
             haSync.applyUpdateToVariable(var, &value, false);
@@ -132,7 +132,8 @@ void setupHASensor(HASensor *sensor, const VariableUOM *uom) {
 }
 
 MqttHASync::MqttHASync() : BaseSync() {
-    this->renewValueCount = 0;
+    this->maxAge = 0;
+    this->loopInterval = MQTT_LOOP_MS_PERIOD;
 
     WiFiClient *wifiClient = new WiFiClient;
 
@@ -267,6 +268,26 @@ void MqttHASync::loop() {
     Controller::getInstance().setErrorFlag(STATUS_ERR_NO_MQTT_CONNECTION, !mqtt->isConnected());
     mqtt->loop();
 }
+#ifdef USE_SYNC_DIAGNOSTICS
+bool MqttHASync::sendDiagnostics(const char *name, const char *json) {
+    if (!this->mqtt->isConnected()) {
+        return false;
+    }
+    char topic[sizeof(MQTT_DIAGNOSTICS_TOPIC) + 8];
+    snprintf(topic, sizeof(topic), MQTT_DIAGNOSTICS_TOPIC "%s", name);
+    return this->mqtt->publish(topic, json, RETAIN_ALL_MSG);
+}
+#endif
+#ifdef USE_VARIABLE_RULES
+bool MqttHASync::sendAlarm(const char *message) {
+#ifdef USE_MQTT_RAW_TOPICS
+    // already published by the raw topics on the same broker
+    return false;
+#else
+    return this->mqtt->isConnected() && this->mqtt->publish(MQTT_ALARM_TOPIC, message);
+#endif
+}
+#endif
 bool MqttHASync::isVariableAllowed(const VariableDefinition *def) {
     return def->mqttTopic != nullptr;
 }
@@ -301,7 +322,7 @@ bool MqttHASync::sendUpdateToVariable(const VariableDefinition *def, const void
 }
 
 // upload values stats
-void MqttHASync::uploadStatsToMqtt() {
+void MqttHASync::uploadStats() {
     if (!this->mqtt->isConnected()) {
         return;
     }
@@ -310,14 +331,14 @@ void MqttHASync::uploadStatsToMqtt() {
 }
 
 // upload values realtime
-void MqttHASync::uploadRealtimeToMqtt() {
+void MqttHASync::uploadRealtime() {
     if (!this->mqtt->isConnected()) {
         return;
     }
 
 #ifdef MQTT_TOPIC_INTERNAL_STATUS
     uint16_t status = Controller::getInstance().getStatus();
-    this->syncVariable(VariableDefiner::getInstance().getDefinition(Variable::INTERNAL_STATUS), &(status));
+    this->sendUpdateToVariable(VariableDefiner::getInstance().getDefinition(Variable::INTERNAL_STATUS), &(status));
 #endif
     this->sendUpdateAllBySource(VariableSource::SR_REALTIME, false);
 }
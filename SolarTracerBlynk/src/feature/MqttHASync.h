@@ -43,12 +43,23 @@ class MqttHASync : public BaseSync {
         inline bool isVariableAllowed(const VariableDefinition *def);
         bool sendUpdateToVariable(const VariableDefinition *def, const void *value);
         // upload values stats
-        void uploadStatsToMqtt();
+        void uploadStats();
         // upload values realtime
-        void uploadRealtimeToMqtt();
+        void uploadRealtime();
+#ifdef USE_SYNC_DIAGNOSTICS
+        bool sendDiagnostics(const char *name, const char *json);
+#endif
+#ifdef USE_VARIABLE_RULES
+        bool sendAlarm(const char *message);
+#endif
 
         Variable findVariableBySensor(HABaseDeviceType *haSensor);
 
+        /**
+         * Broker connection, shared with the raw topics (USE_MQTT_HOME_ASSISTANT_RAW_TOPICS)
+         */
+        inline HAMqtt *getMqtt();
+
     private:
         MqttHASync();
 
@@ -59,4 +70,8 @@ class MqttHASync : public BaseSync {
         bool initialized;
 };
 
+HAMqtt *MqttHASync::getMqtt() {
+    return this->mqtt;
+}
+
 #endif
@@ -23,9 +23,12 @@
 
 #include "../incl/include_all_core.h"
 
-#if defined(USE_MQTT) && !defined(USE_MQTT_HOME_ASSISTANT)
+#if defined(USE_MQTT_RAW_TOPICS)
 
 #include "../core/datetime.h"
+#ifdef USE_VARIABLE_HISTORY
+#include "VariableHistory.h"
+#endif
 
 #define RETAIN_ALL_MSG false
 #define MQTT_CONNECT_ATTEMPT 3
@@ -34,6 +37,22 @@
 DynamicJsonDocument json(1024);
 #endif
 void mqttCallback(char *topic, uint8_t *bytes, unsigned int length) {
+#ifdef USE_VARIABLE_HISTORY
+    if (strcmp(topic, MQTT_TOPIC_ROOT MQTT_HISTORY_REQUEST_TOPIC) == 0) {
+        char request[48];
+        snprintf(request, sizeof(request), "%.*s", (int)length, (const char *)bytes);
+        MqttSync::getInstance().requestHistory(request);
+        return;
+    }
+#endif
+#ifndef USE_MQTT_RPC_SUBSCRIBE
+    // the wildcard subscription also delivers the values published by this board: drop them first
+    const VariableDefinition *def = VariableDefiner::getInstance().getDefinitionByMqttTopic(topic);
+    if (def == nullptr || def->mode != MD_READWRITE) {
+        return;
+    }
+#endif
+
     String payload;
     for (int i = 0; i < length; i++) {
         payload += (char)bytes[i];
@@ -43,11 +62,9 @@ void mqttCallback(char *topic, uint8_t *bytes, unsigned int length) {
     deserializeJson(json, payload);
     const char *constTopic = json["method"].as<const char *>();
     payload = json["params"].as<String>();
-#else
-    const char *constTopic = topic;
-#endif
 
     const VariableDefinition *def = VariableDefiner::getInstance().getDefinitionByMqttTopic(topic);
+#endif
 
     if (def != nullptr && def->mode == MD_READWRITE) {
         if (def->source == VariableSource::SR_INTERNAL) {
@@ -64,8 +81,8 @@ void mqttCallback(char *topic, uint8_t *bytes, unsigned int length) {
                     if (payload.toInt() > 0) {
                         debugPrintln("REQUEST ALL VALUES TO CONTROLLER");
                         Controller::getInstance().getSolarController()->fetchAllValues();
-                        MqttSync::getInstance().uploadRealtimeToMqtt();
-                        MqttSync::getInstance().uploadStatsToMqtt();
+                        MqttSync::getInstance().uploadRealtime();
+                        MqttSync::getInstance().uploadStats();
                     }
                 } break;
             }
@@ -88,37 +105,107 @@ void mqttCallback(char *topic, uint8_t *bytes, unsigned int length) {
     }
 }
 
+#ifdef USE_MQTT_HOME_ASSISTANT
+void mqttSharedCallback(const char *topic, const uint8_t *bytes, uint16_t length) {
+#ifndef USE_MQTT_RPC_SUBSCRIBE
+    // home assistant messages are delivered here too: keep the raw topics only
+    if (strncmp(topic, MQTT_RAW_TOPIC_ROOT, MQTT_RAW_TOPIC_ROOT_LENGTH) != 0) {
+        return;
+    }
+    topic += MQTT_RAW_TOPIC_ROOT_LENGTH;
+#endif
+    mqttCallback((char *)topic, (uint8_t *)bytes, length);
+}
+#endif
+
 MqttSync::MqttSync() {
+    this->loopInterval = MQTT_LOOP_MS_PERIOD;
+#ifdef USE_MQTT_HOME_ASSISTANT
+    this->mqttClient = MqttHASync::getInstance().getMqtt();
+    strcpy(this->topicBuffer, MQTT_RAW_TOPIC_ROOT);
+#ifdef USE_SYNC_OUTBOX
+    // the connection is polled by MqttHASync, only the replay is left
+    this->loopInterval = MQTT_OUTBOX_REPLAY_MS_PERIOD;
+#endif
+#else
     WiFiClient *espClient = new WiFiClient();
     this->mqttClient = new PubSubClient(*espClient);
+#endif
 }
 
 void MqttSync::setup() {
+#ifdef USE_MQTT_HOME_ASSISTANT
+    // connected by MqttHASync, subscriptions are restored on every connection
+    this->mqttClient->onMessage(mqttSharedCallback);
+    this->mqttClient->onConnected([]() { MqttSync::getInstance().subscribe(); });
+    if (this->mqttClient->isConnected()) {
+        this->subscribe();
+    }
+#else
     this->mqttClient->setServer(Environment::getData()->mqttServerHostname, Environment::getData()->mqttServerPort);
 
     mqttClient->setCallback(mqttCallback);
+#endif
+#ifdef USE_SYNC_OUTBOX
+#ifndef USE_MQTT_HOME_ASSISTANT
+    // HAMqtt streams the payloads, no buffer limit
+    this->mqttClient->setBufferSize(sizeof(this->replayBuffer) + strlen(MQTT_OUTBOX_REPLAY_TOPIC) + 8);
+#endif
+    this->outbox.setup();
+#endif
+
+#ifndef USE_MQTT_HOME_ASSISTANT
+    this->connect();
+#endif
+}
+
+bool MqttSync::isConnected() {
+#ifdef USE_MQTT_HOME_ASSISTANT
+    return this->mqttClient->isConnected();
+#else
+    return this->mqttClient->connected();
+#endif
+}
+
+const char *MqttSync::getTopic(const VariableDefinition *def) {
+#ifdef USE_MQTT_HOME_ASSISTANT
+    // variable topics are the home assistant ids, without root
+    snprintf(this->topicBuffer + MQTT_RAW_TOPIC_ROOT_LENGTH, sizeof(this->topicBuffer) - MQTT_RAW_TOPIC_ROOT_LENGTH, "%s", def->mqttTopic);
+    return this->topicBuffer;
+#else
+    return def->mqttTopic;
+#endif
+}
+
+void MqttSync::subscribe() {
+#ifdef USE_MQTT_HOME_ASSISTANT
+    this->mqttClient->subscribe(MQTT_RAW_TOPIC_ROOT "#");
+#else
+    if (MQTT_TOPIC_ROOT_LENGTH > 0) {
+        // a single subscription, topics are routed by VariableDefiner::getDefinitionByMqttTopic
+        this->mqttClient->subscribe(MQTT_TOPIC_ROOT "#");
+        return;
+    }
     for (uint8_t index = 0; index < Variable::VARIABLES_COUNT; index++) {
         const VariableDefinition *def = VariableDefiner::getInstance().getDefinition((Variable)index);
         if (def->mqttTopic != nullptr && def->mode == MD_READWRITE && (def->source == VariableSource::SR_INTERNAL || Controller::getInstance().getSolarController()->isVariableEnabled(def->variable))) {
             this->mqttClient->subscribe(def->mqttTopic);
         }
     }
-
-    this->connect();
+#endif
 }
 
 void MqttSync::connect(bool blocking) {
+#ifdef USE_MQTT_HOME_ASSISTANT
+    // the shared connection is handled by MqttHASync
+#else
     debugPrintf(true, Text::setupWithName, "MQTT");
     debugPrint(Text::connecting);
 
     uint8_t counter = 0;
 
     do {
-        mqttClient->connect(
-
-            Environment::getData()->mqttClientId,
-            strlen(Environment::getData()->mqttUsername) > 0 ? Environment::getData()->mqttUsername : nullptr,
-            strlen(Environment::getData()->mqttPassword) > 0 ? Environment::getData()->mqttPassword : nullptr);
+        this->connectClient();
         while (!mqttClient->connected() && counter < 10) {
             debugPrint(Text::dot);
             delay(500);
@@ -129,20 +216,167 @@ void MqttSync::connect(bool blocking) {
             debugPrintf(true, Text::errorWithCode, mqttClient->state());
         } else {
             debugPrintln(Text::ok);
+            this->subscribe();
         }
 
     } while (blocking && !mqttClient->connected());
 
     Controller::getInstance().setErrorFlag(STATUS_ERR_NO_MQTT_CONNECTION, !mqttClient->connected());
+#endif
+}
+#ifndef USE_MQTT_HOME_ASSISTANT
+bool MqttSync::connectClient() {
+    return mqttClient->connect(
+        Environment::getData()->mqttClientId,
+        strlen(Environment::getData()->mqttUsername) > 0 ? Environment::getData()->mqttUsername : nullptr,
+        strlen(Environment::getData()->mqttPassword) > 0 ? Environment::getData()->mqttPassword : nullptr);
 }
+
+void MqttSync::reconnect() {
+    uint32_t now = millis();
+    if (now - this->lastReconnectMillis < this->reconnectDelay) {
+        return;
+    }
+    this->lastReconnectMillis = now;
+    if (!WiFi.isConnected() || !this->connectClient()) {
+        this->reconnectDelay = this->reconnectDelay * 2 < MQTT_RECONNECT_MAX_MS ? this->reconnectDelay * 2 : MQTT_RECONNECT_MAX_MS;
+        return;
+    }
+    debugPrintln("MQTT reconnected");
+    // subscriptions are lost with the connection
+    this->subscribe();
+    this->reconnectDelay = MQTT_RECONNECT_MIN_MS;
+#ifdef USE_SYNC_OUTBOX
+    // the queued values are replayed from the next loop
+    this->lastReplayMillis = now - MQTT_OUTBOX_REPLAY_MS_PERIOD;
+#endif
+}
+#endif
+
 void MqttSync::loop() {
+#ifndef USE_MQTT_HOME_ASSISTANT
+    if (!mqttClient->connected()) {
+        this->reconnect();
+    }
     Controller::getInstance().setErrorFlag(STATUS_ERR_NO_MQTT_CONNECTION, !mqttClient->connected());
     mqttClient->loop();
+#endif
+#ifdef USE_SYNC_OUTBOX
+    if (this->isConnected() && !this->outbox.isEmpty() && millis() - this->lastReplayMillis >= MQTT_OUTBOX_REPLAY_MS_PERIOD) {
+        this->lastReplayMillis = millis();
+        this->replayOutbox();
+    }
+#endif
+#ifdef USE_VARIABLE_HISTORY
+    if (this->historyVariable != Variable::VARIABLES_COUNT && this->isConnected() && millis() - this->lastHistoryMillis >= MQTT_HISTORY_MS_PERIOD) {
+        this->lastHistoryMillis = millis();
+        this->publishHistory();
+    }
+#endif
+}
+
+#ifdef USE_SYNC_OUTBOX
+void MqttSync::replayOutbox() {
+    SyncOutboxRecord records[MQTT_OUTBOX_REPLAY_BATCH];
+    uint8_t count = this->outbox.peek(records, MQTT_OUTBOX_REPLAY_BATCH);
+    if (count == 0) {
+        return;
+    }
+    size_t length = 0;
+    this->replayBuffer[length++] = '[';
+    for (uint8_t index = 0; index < count; index++) {
+        const VariableDefinition *def = VariableDefiner::getInstance().getDefinition((Variable)records[index].variable);
+        int written = snprintf(this->replayBuffer + length, MQTT_OUTBOX_REPLAY_RECORD_SIZE, "%s{\"t\":%lu,\"k\":\"%s\",\"v\":%.4f}",
+                           index > 0 ? "," : "", (unsigned long)records[index].timestamp, def->mqttTopic != nullptr ? def->mqttTopic + MQTT_TOPIC_ROOT_LENGTH : "", records[index].value);
+        length += written < MQTT_OUTBOX_REPLAY_RECORD_SIZE ? written : MQTT_OUTBOX_REPLAY_RECORD_SIZE - 1;
+    }
+    this->replayBuffer[length++] = ']';
+    this->replayBuffer[length] = '\0';
+    if (this->mqttClient->publish(MQTT_OUTBOX_REPLAY_TOPIC, this->replayBuffer, RETAIN_ALL_MSG)) {
+        this->outbox.pop(count);
+    }
+}
+#endif
+#ifdef USE_VARIABLE_HISTORY
+void MqttSync::requestHistory(const char *request) {
+    char topic[64];
+    const char *separator = strchr(request, ' ');
+    snprintf(topic, sizeof(topic), MQTT_TOPIC_ROOT "%.*s", (int)(separator != nullptr ? separator - request : strlen(request)), request);
+    uint32_t seconds = separator != nullptr ? strtoul(separator + 1, nullptr, 10) : 0;
+
+    const VariableDefinition *def = VariableDefiner::getInstance().getDefinitionByMqttTopic(topic);
+    if (def == nullptr || VariableHistory::getSeries(def->variable) == nullptr) {
+        debugPrint("ERROR: no history for ");
+        debugPrintln(request);
+        return;
+    }
+    this->historyTo = VariableHistory::now();
+    this->historyFrom = seconds > 0 && seconds < this->historyTo ? this->historyTo - seconds : 0;
+    this->historyVariable = def->variable;
+}
+
+void MqttSync::publishHistory() {
+    TimeSeriesSample samples[MQTT_HISTORY_BATCH];
+    uint16_t count = VariableHistory::read(this->historyVariable, this->historyFrom, this->historyTo, samples, MQTT_HISTORY_BATCH);
+    if (count == 0) {
+        this->historyVariable = Variable::VARIABLES_COUNT;
+        return;
+    }
+    const char *key = VariableDefiner::getInstance().getDefinition(this->historyVariable)->mqttTopic + MQTT_TOPIC_ROOT_LENGTH;
+    size_t length = 0;
+    this->historyBuffer[length++] = '[';
+    for (uint8_t index = 0; index < count; index++) {
+        int written = snprintf(this->historyBuffer + length, MQTT_HISTORY_RECORD_SIZE, "%s{\"t\":%lu,\"k\":\"%s\",\"v\":%.2f}",
+                               index > 0 ? "," : "", (unsigned long)samples[index].time, key, samples[index].value);
+        length += written < MQTT_HISTORY_RECORD_SIZE ? written : MQTT_HISTORY_RECORD_SIZE - 1;
+    }
+    this->historyBuffer[length++] = ']';
+    this->historyBuffer[length] = '\0';
+    if (this->publishLarge(MQTT_HISTORY_TOPIC, this->historyBuffer)) {
+        // samples are at least 1s apart: the next batch starts after the last one sent
+        this->historyFrom = samples[count - 1].time + 1;
+        if (count < MQTT_HISTORY_BATCH) {
+            this->historyVariable = Variable::VARIABLES_COUNT;
+        }
+    }
+}
+#endif
+#if defined(USE_SYNC_DIAGNOSTICS) || defined(USE_VARIABLE_HISTORY)
+bool MqttSync::publishLarge(const char *topic, const char *payload) {
+#ifdef USE_MQTT_HOME_ASSISTANT
+    return this->mqttClient->publish(topic, payload, RETAIN_ALL_MSG);
+#else
+    // streamed, larger than the client buffer
+    size_t length = strlen(payload);
+    return this->mqttClient->beginPublish(topic, length, RETAIN_ALL_MSG) && this->mqttClient->write((const uint8_t *)payload, length) == length && this->mqttClient->endPublish();
+#endif
+}
+#endif
+#ifdef USE_SYNC_DIAGNOSTICS
+bool MqttSync::sendDiagnostics(const char *name, const char *json) {
+    if (!this->isConnected()) {
+        return false;
+    }
+    char topic[sizeof(MQTT_DIAGNOSTICS_TOPIC) + 8];
+    snprintf(topic, sizeof(topic), MQTT_DIAGNOSTICS_TOPIC "%s", name);
+    return this->publishLarge(topic, json);
+}
+#endif
+#ifdef USE_VARIABLE_RULES
+bool MqttSync::sendAlarm(const char *message) {
+    return this->isConnected() && this->mqttClient->publish(MQTT_ALARM_TOPIC, message);
 }
+#endif
 bool MqttSync::isVariableAllowed(const VariableDefinition *def) {
     return def->mqttTopic != nullptr;
 }
 bool MqttSync::sendUpdateToVariable(const VariableDefinition *def, const void *value) {
+#ifdef USE_SYNC_OUTBOX
+    if (!this->isConnected()) {
+        // strings are not queued, they are sent on reconnect if still pending
+        return def->datatype != VariableDatatype::DT_STRING && this->outbox.push(def->variable, BaseSync::getNumericValue(def, value));
+    }
+#endif
     switch (def->datatype) {
         case VariableDatatype::DT_UINT16:
 #ifdef USE_MQTT_JSON_PUBLISH
@@ -157,29 +391,35 @@ bool MqttSync::sendUpdateToVariable(const VariableDefinition *def, const void *v
             return true;
 #else
             dtostrf(*(float *)value, 0, 4, mqttPublishBuffer);
-            return mqttClient->publish(def->mqttTopic, mqttPublishBuffer, RETAIN_ALL_MSG);
+            return mqttClient->publish(this->getTopic(def), mqttPublishBuffer, RETAIN_ALL_MSG);
 #endif
         case VariableDatatype::DT_BOOL:
 #ifdef USE_MQTT_JSON_PUBLISH
             syncJson[def->mqttTopic] = *(bool *)value;
             return true;
 #else
-            return mqttClient->publish(def->mqttTopic, (*(const bool *)value) ? "1" : "0", RETAIN_ALL_MSG);
+            return mqttClient->publish(this->getTopic(def), (*(const bool *)value) ? "1" : "0", RETAIN_ALL_MSG);
 #endif
         case VariableDatatype::DT_STRING:
 #ifdef USE_MQTT_JSON_PUBLISH
             syncJson[def->mqttTopic] = *(const char *)value;
             return true;
 #else
-            return mqttClient->publish(def->mqttTopic, (const char *)value, RETAIN_ALL_MSG);
+            return mqttClient->publish(this->getTopic(def), (const char *)value, RETAIN_ALL_MSG);
 #endif
     }
     return false;
 }
 
 // upload values stats
-void MqttSync::uploadStatsToMqtt() {
-    if (!this->mqttClient->connected()) {
+void MqttSync::uploadStats() {
+    if (!this->isConnected()) {
+#ifdef USE_SYNC_OUTBOX
+        // changes go to the outbox
+        this->queueing = true;
+        this->sendUpdateAllBySource(VariableSource::SR_STATS, true);
+        this->queueing = false;
+#endif
         return;
     }
 
@@ -194,8 +434,14 @@ void MqttSync::uploadStatsToMqtt() {
 }
 
 // upload values realtime
-void MqttSync::uploadRealtimeToMqtt() {
-    if (!this->mqttClient->connected()) {
+void MqttSync::uploadRealtime() {
+    if (!this->isConnected()) {
+#ifdef USE_SYNC_OUTBOX
+        // changes go to the outbox
+        this->queueing = true;
+        this->sendUpdateAllBySource(VariableSource::SR_REALTIME, true);
+        this->queueing = false;
+#endif
         return;
     }
 
@@ -23,12 +23,37 @@
 
 #include "../incl/include_all_core.h"
 
-#if defined(USE_MQTT) && !defined(USE_MQTT_HOME_ASSISTANT)
+#if defined(USE_MQTT_RAW_TOPICS)
 
 #include "../core/BaseSync.h"
 #include "../core/Controller.h"
+#include "../core/SyncOutbox.h"
 #include "../core/VariableDefiner.h"
 #include "../incl/include_all_lib.h"
+#ifdef USE_MQTT_HOME_ASSISTANT
+#include "MqttHASync.h"
+
+#define MQTT_RAW_TOPIC_ROOT_LENGTH (sizeof(MQTT_RAW_TOPIC_ROOT) - 1)
+#else
+// ms between 2 reconnection attempts, doubled on each failure up to MQTT_RECONNECT_MAX_MS
+#ifndef MQTT_RECONNECT_MIN_MS
+#define MQTT_RECONNECT_MIN_MS 5000L
+#endif
+#ifndef MQTT_RECONNECT_MAX_MS
+#define MQTT_RECONNECT_MAX_MS 60000L
+#endif
+#endif
+
+#ifdef USE_SYNC_OUTBOX
+#define MQTT_OUTBOX_PERSISTENCE "/mqtt_outbox.bin"
+// max length of a record in the replay message
+#define MQTT_OUTBOX_REPLAY_RECORD_SIZE 96
+#endif
+
+#ifdef USE_VARIABLE_HISTORY
+// max length of a sample in the history message
+#define MQTT_HISTORY_RECORD_SIZE 64
+#endif
 
 class MqttSync : public BaseSync {
     public:
@@ -43,17 +68,100 @@ class MqttSync : public BaseSync {
         inline bool isVariableAllowed(const VariableDefinition *def);
         bool sendUpdateToVariable(const VariableDefinition *def, const void *value);
         // upload values stats
-        void uploadStatsToMqtt();
+        void uploadStats();
         // upload values realtime
-        void uploadRealtimeToMqtt();
+        void uploadRealtime();
+#ifdef USE_SYNC_OUTBOX
+        uint16_t getQueuedCount() {
+            return this->outbox.getCount();
+        }
+        uint16_t getDroppedCount() {
+            return this->outbox.getDroppedCount();
+        }
+#endif
+#ifdef USE_SYNC_DIAGNOSTICS
+        bool sendDiagnostics(const char *name, const char *json);
+#endif
+#ifdef USE_VARIABLE_RULES
+        bool sendAlarm(const char *message);
+#endif
+#ifdef USE_VARIABLE_HISTORY
+        /**
+         * Start publishing the history of a variable, request: "topic without root [seconds back]"
+         */
+        void requestHistory(const char *request);
+#endif
 
     private:
         MqttSync();
 
+        /**
+         * Subscribe to the writable topics, subscriptions are lost when disconnected
+         */
+        void subscribe();
+
+        inline bool isConnected();
+
+        /**
+         * Topic to publish the variable to
+         */
+        inline const char *getTopic(const VariableDefinition *def);
+
+#ifdef USE_MQTT_HOME_ASSISTANT
+        // broker connection owned by MqttHASync
+        HAMqtt *mqttClient;
+        // MQTT_RAW_TOPIC_ROOT + variable topic
+        char topicBuffer[MQTT_RAW_TOPIC_ROOT_LENGTH + 64];
+#else
         PubSubClient *mqttClient;
+        uint32_t lastReconnectMillis = 0;
+        uint32_t reconnectDelay = MQTT_RECONNECT_MIN_MS;
+
+        /**
+         * Single connection attempt to the broker
+         */
+        bool connectClient();
+
+        /**
+         * Try to connect again once the backoff is elapsed, without waiting for the broker
+         */
+        void reconnect();
+#endif
 
         char mqttPublishBuffer[20];
 
+#if defined(USE_SYNC_DIAGNOSTICS) || defined(USE_VARIABLE_HISTORY)
+        /**
+         * Publish a payload larger than the client buffer
+         */
+        bool publishLarge(const char *topic, const char *payload);
+#endif
+
+#ifdef USE_VARIABLE_HISTORY
+        // variable of the history being published, VARIABLES_COUNT if none
+        Variable historyVariable = Variable::VARIABLES_COUNT;
+        uint32_t historyFrom;
+        uint32_t historyTo;
+        uint32_t lastHistoryMillis = 0;
+        char historyBuffer[MQTT_HISTORY_BATCH * MQTT_HISTORY_RECORD_SIZE + 3];
+
+        /**
+         * Publish the next batch of the requested history: [{"t":timestamp,"k":"topic without root","v":value},...]
+         */
+        void publishHistory();
+#endif
+
+#ifdef USE_SYNC_OUTBOX
+        SyncOutbox outbox = SyncOutbox(MQTT_OUTBOX_PERSISTENCE);
+        uint32_t lastReplayMillis = 0;
+        char replayBuffer[MQTT_OUTBOX_REPLAY_BATCH * MQTT_OUTBOX_REPLAY_RECORD_SIZE + 3];
+
+        /**
+         * Publish a batch of the queued values: [{"t":timestamp,"k":"topic without root","v":value},...]
+         */
+        void replayOutbox();
+#endif
+
 #if defined(USE_MQTT_RPC_SUBSCRIBE) || defined(USE_MQTT_JSON_PUBLISH)
         DynamicJsonDocument syncJson(1024);
 #endif
@@ -0,0 +1,82 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../incl/include_all_core.h"
+
+#ifdef USE_VARIABLE_HISTORY
+
+#include "VariableHistory.h"
+
+static const Variable historyVariables[] = {VARIABLE_HISTORY_VARIABLES};
+#define VARIABLE_HISTORY_COUNT (sizeof(historyVariables) / sizeof(Variable))
+static TimeSeries historySeries[VARIABLE_HISTORY_COUNT];
+
+SolarTracer *VariableHistory::tracer = nullptr;
+
+void VariableHistory::setup(SolarTracer *tracer) {
+    VariableHistory::tracer = tracer;
+}
+
+void VariableHistory::sample() {
+    uint32_t time = VariableHistory::now();
+    for (uint8_t index = 0; index < VARIABLE_HISTORY_COUNT; index++) {
+        Variable variable = historyVariables[index];
+        if (!tracer->isVariableReadReady(variable)) {
+            continue;
+        }
+        const void *value = tracer->getValue(variable);
+        switch (VariableDefiner::getInstance().getDatatype(variable)) {
+            case VariableDatatype::DT_FLOAT:
+                historySeries[index].append(time, *(const float *)value);
+                break;
+            case VariableDatatype::DT_UINT16:
+                historySeries[index].append(time, *(const uint16_t *)value);
+                break;
+            case VariableDatatype::DT_BOOL:
+                historySeries[index].append(time, *(const bool *)value ? 1 : 0);
+                break;
+            default:
+                // text is not recorded
+                break;
+        }
+    }
+}
+
+TimeSeries *VariableHistory::getSeries(Variable variable) {
+    for (uint8_t index = 0; index < VARIABLE_HISTORY_COUNT; index++) {
+        if (historyVariables[index] == variable) {
+            return &(historySeries[index]);
+        }
+    }
+    return nullptr;
+}
+
+uint16_t VariableHistory::read(Variable variable, uint32_t from, uint32_t to, TimeSeriesSample *samples, uint16_t maxSamples) {
+    TimeSeries *series = VariableHistory::getSeries(variable);
+    return series != nullptr ? series->read(from, to, samples, maxSamples) : 0;
+}
+
+bool VariableHistory::aggregate(Variable variable, uint32_t from, uint32_t to, TimeSeriesAggregate &result) {
+    TimeSeries *series = VariableHistory::getSeries(variable);
+    return series != nullptr && series->aggregate(from, to, result);
+}
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#ifndef VARIABLE_HISTORY_H
+#define VARIABLE_HISTORY_H
+
+#include "../incl/include_all_core.h"
+
+#ifdef USE_VARIABLE_HISTORY
+
+#include "../core/TimeSeries.h"
+#include "../solartracer/SolarTracer.h"
+
+#ifndef VARIABLE_HISTORY_MS_PERIOD
+#define VARIABLE_HISTORY_MS_PERIOD CONTROLLER_UPDATE_MS_PERIOD
+#endif
+
+/**
+ * Compressed history of the variables listed in VARIABLE_HISTORY_VARIABLES,
+ * kept in RAM and published on request by MqttSync.
+ */
+class VariableHistory {
+    public:
+        static void setup(SolarTracer *tracer);
+
+        /**
+         * Record the current value of each variable (only the ready ones)
+         */
+        static void sample();
+
+        /**
+         * Series of the variable, null if the variable is not recorded
+         */
+        static TimeSeries *getSeries(Variable variable);
+
+        static uint16_t read(Variable variable, uint32_t from, uint32_t to, TimeSeriesSample *samples, uint16_t maxSamples);
+
+        static bool aggregate(Variable variable, uint32_t from, uint32_t to, TimeSeriesAggregate &result);
+
+        /**
+         * Current time of the samples (seconds)
+         */
+        static inline uint32_t now() {
+            return time(nullptr);
+        }
+
+    private:
+        static SolarTracer *tracer;
+};
+
+#endif
+
+#endif
@@ -0,0 +1,262 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../incl/include_all_core.h"
+
+#ifdef USE_VARIABLE_ROLLUP
+
+#include "VariableRollup.h"
+
+#include <float.h>
+
+#include "../core/datetime.h"
+#include "../incl/include_all_lib.h"
+
+#define _ROLLUP_CHECK(variable, input, window, aggregate)                                                  \
+    static_assert(VariableInfo<Variable::variable>::datatype == VariableDatatype::DT_FLOAT &&              \
+                      VariableInfo<Variable::input>::datatype == VariableDatatype::DT_FLOAT,               \
+                  "Rollup variables and their inputs must be float");
+ROLLUP_VARIABLE_LIST(_ROLLUP_CHECK)
+#undef _ROLLUP_CHECK
+
+#define _ROLLUP_INITIALIZE(variable, input, window, aggregate) \
+    {Variable::variable, Variable::input, RollupWindow::window, RollupAggregate::aggregate},
+static const RollupDefinition rollupDefinitions[] = {ROLLUP_VARIABLE_LIST(_ROLLUP_INITIALIZE)};
+#undef _ROLLUP_INITIALIZE
+
+#define VARIABLE_ROLLUP_COUNT (sizeof(rollupDefinitions) / sizeof(RollupDefinition))
+
+// window ids based on the uptime (no local time available), never restored after a reboot
+#define VARIABLE_ROLLUP_UPTIME_WINDOW 0x80000000UL
+
+static RollupAccumulator rollupAccumulators[VARIABLE_ROLLUP_COUNT];
+
+/**
+ * Last value of the input of each rollup, held until the next change
+ */
+static struct {
+        float value;
+        bool ready;
+        uint32_t since;
+} rollupInputs[VARIABLE_ROLLUP_COUNT];
+
+/**
+ * Content of VARIABLE_ROLLUP_PERSISTENCE
+ */
+static struct {
+        uint8_t version;
+        RollupAccumulator accumulators[VARIABLE_ROLLUP_COUNT];
+        float closedValues[VARIABLE_ROLLUP_COUNT];
+        bool closedReady[VARIABLE_ROLLUP_COUNT];
+} rollupPersistence;
+
+SolarTracer *VariableRollup::tracer = nullptr;
+
+void VariableRollup::setup(SolarTracer *tracer) {
+    VariableRollup::tracer = tracer;
+    uint32_t now = millis();
+
+    for (uint8_t index = 0; index < VARIABLE_ROLLUP_COUNT; index++) {
+        const RollupDefinition *definition = &(rollupDefinitions[index]);
+        // set by this module, not by the scc
+        tracer->setVariableOverWritten(definition->variable, true);
+
+        rollupInputs[index].ready = tracer->isVariableReadReady(definition->input);
+        rollupInputs[index].value = rollupInputs[index].ready ? *(const float *)tracer->getValue(definition->input) : 0;
+        rollupInputs[index].since = now;
+        VariableRollup::resetAccumulator(index, VariableRollup::getWindowId(definition->window));
+
+        // one subscription for each input
+        bool subscribed = false;
+        for (uint8_t previous = 0; previous < index && !subscribed; previous++) {
+            subscribed = rollupDefinitions[previous].input == definition->input;
+        }
+        if (!subscribed && !tracer->subscribe(definition->input, VariableRollup::onInputChanged)) {
+            // the rollup would never be updated
+            debugPrintf(true, "ERROR: rollup %i, cannot subscribe (max %i subscriptions)", index, SOLAR_TRACER_MAX_SUBSCRIPTIONS);
+        }
+    }
+
+    VariableRollup::load();
+}
+
+void VariableRollup::update() {
+    uint32_t now = millis();
+    uint32_t windowIds[] = {
+        VariableRollup::getWindowId(RollupWindow::RW_MINUTE),
+        VariableRollup::getWindowId(RollupWindow::RW_HOUR),
+        VariableRollup::getWindowId(RollupWindow::RW_DAY)};
+    bool persist = false;
+
+    for (uint8_t index = 0; index < VARIABLE_ROLLUP_COUNT; index++) {
+        VariableRollup::integrate(index, now);
+        uint32_t windowId = windowIds[rollupDefinitions[index].window];
+        if (windowId != rollupAccumulators[index].windowId) {
+            VariableRollup::closeWindow(index);
+            VariableRollup::resetAccumulator(index, windowId);
+            // at most 25 writes a day
+            persist = persist || rollupDefinitions[index].window != RollupWindow::RW_MINUTE;
+        }
+    }
+
+    if (persist) {
+        VariableRollup::save();
+    }
+}
+
+void VariableRollup::onInputChanged(Variable variable, const void *oldValue, const void *newValue) {
+    uint32_t now = millis();
+    for (uint8_t index = 0; index < VARIABLE_ROLLUP_COUNT; index++) {
+        if (rollupDefinitions[index].input != variable) {
+            continue;
+        }
+        VariableRollup::integrate(index, now);
+        rollupInputs[index].ready = newValue != nullptr;
+        if (rollupInputs[index].ready) {
+            float value = *(const float *)newValue;
+            rollupInputs[index].value = value;
+            rollupAccumulators[index].min = value < rollupAccumulators[index].min ? value : rollupAccumulators[index].min;
+            rollupAccumulators[index].max = value > rollupAccumulators[index].max ? value : rollupAccumulators[index].max;
+        }
+    }
+}
+
+void VariableRollup::integrate(uint8_t index, uint32_t now) {
+    if (rollupInputs[index].ready) {
+        uint32_t elapsed = now - rollupInputs[index].since;
+        rollupAccumulators[index].integral += (double)rollupInputs[index].value * elapsed;
+        rollupAccumulators[index].duration += elapsed;
+    }
+    rollupInputs[index].since = now;
+}
+
+void VariableRollup::resetAccumulator(uint8_t index, uint32_t windowId) {
+    RollupAccumulator *accumulator = &(rollupAccumulators[index]);
+    accumulator->windowId = windowId;
+    accumulator->integral = 0;
+    accumulator->duration = 0;
+    // the value held is the first one of the new window
+    accumulator->min = rollupInputs[index].ready ? rollupInputs[index].value : FLT_MAX;
+    accumulator->max = rollupInputs[index].ready ? rollupInputs[index].value : -FLT_MAX;
+}
+
+void VariableRollup::closeWindow(uint8_t index) {
+    const RollupAccumulator *accumulator = &(rollupAccumulators[index]);
+    if (accumulator->duration == 0) {
+        // no value in the whole window
+        return;
+    }
+    float value = 0;
+    switch (rollupDefinitions[index].aggregate) {
+        case RollupAggregate::RA_MIN:
+            value = accumulator->min;
+            break;
+        case RollupAggregate::RA_MAX:
+            value = accumulator->max;
+            break;
+        case RollupAggregate::RA_MEAN:
+            value = accumulator->integral / accumulator->duration;
+            break;
+        case RollupAggregate::RA_ENERGY:
+            // W * ms -> kWh
+            value = accumulator->integral / 3600000000.0;
+            break;
+    }
+    tracer->setVariableValue(rollupDefinitions[index].variable, &value, true);
+}
+
+uint32_t VariableRollup::getWindowId(RollupWindow window) {
+    struct tm *ti = Datetime::getMyNowTm();
+    uint32_t minutes;
+    if (ti != nullptr) {
+        minutes = ((ti->tm_year * 366UL + ti->tm_yday) * 24 + ti->tm_hour) * 60 + ti->tm_min;
+    } else {
+        minutes = millis() / 60000UL;
+    }
+
+    switch (window) {
+        case RollupWindow::RW_HOUR:
+            minutes /= 60;
+            break;
+        case RollupWindow::RW_DAY:
+            minutes /= 1440;
+            break;
+        default:
+            break;
+    }
+    return ti != nullptr ? minutes : minutes | VARIABLE_ROLLUP_UPTIME_WINDOW;
+}
+
+void VariableRollup::load() {
+    if (!LittleFS.begin()) {
+        return;
+    }
+    if (LittleFS.exists(VARIABLE_ROLLUP_PERSISTENCE)) {
+        File rollupFile = LittleFS.open(VARIABLE_ROLLUP_PERSISTENCE, "r");
+        if (rollupFile) {
+            if (rollupFile.size() == sizeof(rollupPersistence) &&
+                rollupFile.read((uint8_t *)&rollupPersistence, sizeof(rollupPersistence)) == sizeof(rollupPersistence) &&
+                rollupPersistence.version == VARIABLE_ROLLUP_PERSISTENCE_VERSION) {
+                for (uint8_t index = 0; index < VARIABLE_ROLLUP_COUNT; index++) {
+                    if (rollupPersistence.closedReady[index]) {
+                        tracer->setVariableValue(rollupDefinitions[index].variable, &(rollupPersistence.closedValues[index]), true);
+                    }
+                    // the window is still running: continue from the saved values
+                    const RollupAccumulator *saved = &(rollupPersistence.accumulators[index]);
+                    if ((saved->windowId & VARIABLE_ROLLUP_UPTIME_WINDOW) == 0 && saved->windowId == rollupAccumulators[index].windowId) {
+                        rollupAccumulators[index].integral += saved->integral;
+                        rollupAccumulators[index].duration += saved->duration;
+                        rollupAccumulators[index].min = saved->min < rollupAccumulators[index].min ? saved->min : rollupAccumulators[index].min;
+                        rollupAccumulators[index].max = saved->max > rollupAccumulators[index].max ? saved->max : rollupAccumulators[index].max;
+                    }
+                }
+            } else {
+                debugPrintln("ERROR: cannot restore rollups from file");
+            }
+            rollupFile.close();
+        }
+    }
+    LittleFS.end();
+}
+
+void VariableRollup::save() {
+    rollupPersistence.version = VARIABLE_ROLLUP_PERSISTENCE_VERSION;
+    for (uint8_t index = 0; index < VARIABLE_ROLLUP_COUNT; index++) {
+        Variable variable = rollupDefinitions[index].variable;
+        rollupPersistence.accumulators[index] = rollupAccumulators[index];
+        rollupPersistence.closedReady[index] = tracer->isVariableReadReady(variable);
+        rollupPersistence.closedValues[index] = rollupPersistence.closedReady[index] ? *(const float *)tracer->getValue(variable) : 0;
+    }
+
+    if (!LittleFS.begin()) {
+        return;
+    }
+    File rollupFile = LittleFS.open(VARIABLE_ROLLUP_PERSISTENCE, "w");
+    if (rollupFile) {
+        rollupFile.write((const uint8_t *)&rollupPersistence, sizeof(rollupPersistence));
+        rollupFile.close();
+    } else {
+        debugPrintln("ERROR: cannot save rollups to file");
+    }
+    LittleFS.end();
+}
+
+#endif
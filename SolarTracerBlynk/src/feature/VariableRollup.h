@@ -0,0 +1,113 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#ifndef VARIABLE_ROLLUP_H
+#define VARIABLE_ROLLUP_H
+
+#include "../incl/include_all_core.h"
+
+#ifdef USE_VARIABLE_ROLLUP
+
+#include "../solartracer/SolarTracer.h"
+
+#define VARIABLE_ROLLUP_PERSISTENCE "/rollup.bin"
+#define VARIABLE_ROLLUP_PERSISTENCE_VERSION 1
+
+// ms between 2 checks of the window boundaries
+#ifndef VARIABLE_ROLLUP_MS_PERIOD
+#define VARIABLE_ROLLUP_MS_PERIOD 1000L
+#endif
+
+typedef enum {
+    RW_MINUTE,
+    RW_HOUR,
+    RW_DAY
+} RollupWindow;
+
+typedef enum {
+    RA_MIN,
+    RA_MAX,
+    RA_MEAN,    // time weighted
+    RA_ENERGY   // kWh, input in W
+} RollupAggregate;
+
+struct RollupDefinition {
+        Variable variable;
+        Variable input;
+        RollupWindow window;
+        RollupAggregate aggregate;
+};
+
+/**
+ * Running aggregates of the current window, the input is held between two changes
+ */
+struct RollupAccumulator {
+        uint32_t windowId;
+        float min;
+        float max;
+        // input * ms
+        double integral;
+        // ms
+        uint32_t duration;
+};
+
+/**
+ * Streaming min/max/mean/energy of realtime variables over minute, hour and day windows.
+ *
+ * Each input change costs O(1) per rollup, closed windows are published in the
+ * rollup variables. Running and closed day values are saved at every hour and
+ * day change, so they survive a reboot.
+ */
+class VariableRollup {
+    public:
+        static void setup(SolarTracer *tracer);
+
+        /**
+         * Close the windows that are over, to be called periodically
+         */
+        static void update();
+
+    private:
+        static SolarTracer *tracer;
+
+        static void onInputChanged(Variable variable, const void *oldValue, const void *newValue);
+
+        /**
+         * Add the input held since the last call to the accumulator
+         */
+        static void integrate(uint8_t index, uint32_t now);
+
+        static void resetAccumulator(uint8_t index, uint32_t windowId);
+
+        static void closeWindow(uint8_t index);
+
+        static uint32_t getWindowId(RollupWindow window);
+
+        static void load();
+
+        static void save();
+};
+
+#endif
+
+#endif
@@ -0,0 +1,214 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../incl/include_all_core.h"
+
+#ifdef USE_VARIABLE_RULES
+
+#include "VariableRules.h"
+
+#include "../core/SyncRegistry.h"
+#include "../incl/include_all_lib.h"
+
+static_assert(VARIABLE_RULES_MAX <= 16, "Too many rules, see pendingRules");
+
+static VariableRule rules[VARIABLE_RULES_MAX];
+static uint8_t rulesCount = 0;
+// head of the rule list of each variable, VARIABLE_RULES_MAX if none
+static uint8_t firstRule[Variable::VARIABLES_COUNT];
+// bitmask of the rules fired, waiting for apply()
+static uint16_t pendingRules = 0;
+
+SolarTracer *VariableRules::tracer = nullptr;
+
+void VariableRules::setup(SolarTracer *tracer) {
+    VariableRules::tracer = tracer;
+    memset(firstRule, VARIABLE_RULES_MAX, sizeof(firstRule));
+
+    VariableRules::load();
+
+    // built backwards, to keep the file order within each variable
+    for (uint8_t index = rulesCount; index-- > 0;) {
+        Variable variable = rules[index].variable;
+        if (firstRule[variable] == VARIABLE_RULES_MAX && !tracer->subscribe(variable, VariableRules::onVariableChanged)) {
+            debugPrintf(true, "ERROR: rule %i, cannot subscribe (max %i subscriptions)", index, SOLAR_TRACER_MAX_SUBSCRIPTIONS);
+            continue;
+        }
+        rules[index].next = firstRule[variable];
+        firstRule[variable] = index;
+    }
+    debugPrintf(true, "%i rules loaded", rulesCount);
+}
+
+void VariableRules::onVariableChanged(Variable variable, const void *oldValue, const void *newValue) {
+    if (newValue == nullptr) {
+        // not ready: keep the state until a value is read
+        return;
+    }
+    const VariableDefinition *def = VariableDefiner::getInstance().getDefinition(variable);
+    float value;
+    switch (def->datatype) {
+        case VariableDatatype::DT_FLOAT:
+            value = *(const float *)newValue;
+            break;
+        case VariableDatatype::DT_UINT16:
+            value = *(const uint16_t *)newValue;
+            break;
+        case VariableDatatype::DT_BOOL:
+            value = *(const bool *)newValue ? 1 : 0;
+            break;
+        default:
+            return;
+    }
+
+    for (uint8_t index = firstRule[variable]; index < VARIABLE_RULES_MAX; index = rules[index].next) {
+        VariableRule *rule = &(rules[index]);
+        if (!rule->active) {
+            if (VariableRules::isMatching(rule->op, value, rule->threshold)) {
+                rule->active = true;
+                pendingRules |= (1 << index);
+            }
+        } else {
+            // below/above rules are released past the hysteresis band
+            float release = rule->threshold;
+            if (rule->op == RO_LT || rule->op == RO_LE) {
+                release += rule->hysteresis;
+            } else if (rule->op == RO_GT || rule->op == RO_GE) {
+                release -= rule->hysteresis;
+            }
+            rule->active = VariableRules::isMatching(rule->op, value, release);
+        }
+    }
+}
+
+void VariableRules::apply() {
+    while (pendingRules != 0) {
+        uint8_t index = 0;
+        while ((pendingRules & (1 << index)) == 0) {
+            index++;
+        }
+        pendingRules &= ~(1 << index);
+        const VariableRule *rule = &(rules[index]);
+
+        if (rule->target != Variable::VARIABLES_COUNT) {
+            const VariableDefinition *def = VariableDefiner::getInstance().getDefinition(rule->target);
+            bool boolValue = rule->targetValue != 0;
+            uint16_t uint16Value = rule->targetValue < 0 ? 0 : (uint16_t)rule->targetValue;
+            const void *value = def->datatype == VariableDatatype::DT_BOOL     ? (const void *)&boolValue
+                                : def->datatype == VariableDatatype::DT_UINT16 ? (const void *)&uint16Value
+                                                                               : (const void *)&(rule->targetValue);
+            debugPrintf(false, "RULE %i: write \"%s\" ", index, def->text);
+            tracer->writeValue(rule->target, value) ? debugPrintln(Text::ok) : debugPrintf(true, Text::errorWithCode, tracer->getLastControllerCommunicationStatus());
+        }
+        if (rule->alarm[0] != '\0') {
+            debugPrintf(false, "RULE %i: ", index);
+            debugPrintln(rule->alarm);
+            SyncRegistry::sendAlarmAll(rule->alarm);
+        }
+    }
+}
+
+bool VariableRules::isMatching(VariableRuleOperator op, float value, float threshold) {
+    switch (op) {
+        case RO_LT:
+            return value < threshold;
+        case RO_LE:
+            return value <= threshold;
+        case RO_GT:
+            return value > threshold;
+        case RO_GE:
+            return value >= threshold;
+        case RO_EQ:
+            return value == threshold;
+        case RO_NE:
+            return value != threshold;
+    }
+    return false;
+}
+
+bool VariableRules::parseOperator(const char *text, VariableRuleOperator *op) {
+    static const char *const operators[] = {"<", "<=", ">", ">=", "==", "!="};
+    for (uint8_t index = 0; text != nullptr && index < sizeof(operators) / sizeof(operators[0]); index++) {
+        if (strcmp(operators[index], text) == 0) {
+            *op = (VariableRuleOperator)index;
+            return true;
+        }
+    }
+    return false;
+}
+
+void VariableRules::load() {
+    rulesCount = 0;
+    if (!LittleFS.begin()) {
+        return;
+    }
+    if (LittleFS.exists(VARIABLE_RULES_PERSISTENCE)) {
+        File rulesFile = LittleFS.open(VARIABLE_RULES_PERSISTENCE, "r");
+        if (!rulesFile) {
+            debugPrintln("ERROR: cannot open rules file");
+        } else {
+            DynamicJsonDocument doc(rulesFile.size() * 3);
+            DeserializationError error = deserializeJson(doc, rulesFile);
+            if (error) {
+                debugPrintln("ERROR: Cannot deserialize rules from file");
+                debugPrintln(error.c_str());
+            } else {
+                uint8_t index = 0;
+                for (JsonVariant item : doc.as<JsonArray>()) {
+                    if (rulesCount >= VARIABLE_RULES_MAX) {
+                        debugPrintf(true, "ERROR: rule %i, max %i rules", index, VARIABLE_RULES_MAX);
+                        break;
+                    }
+                    VariableRule *rule = &(rules[rulesCount]);
+                    const char *alarm = item["alarm"].as<const char *>();
+                    // missing or not a name: invalid variable / target below
+                    rule->variable = item["if"].is<const char *>() ? VariableDefiner::getInstance().getVariableByName(item["if"].as<const char *>()) : Variable::VARIABLES_COUNT;
+                    rule->target = item["set"].is<const char *>() ? VariableDefiner::getInstance().getVariableByName(item["set"].as<const char *>()) : Variable::VARIABLES_COUNT;
+                    rule->threshold = item["value"].as<float>();
+                    rule->hysteresis = item["hyst"].as<float>();
+                    rule->targetValue = item["to"].as<float>();
+                    strncpy(rule->alarm, alarm != nullptr ? alarm : "", sizeof(rule->alarm) - 1);
+                    rule->alarm[sizeof(rule->alarm) - 1] = '\0';
+                    rule->active = false;
+                    rule->next = VARIABLE_RULES_MAX;
+
+                    if (rule->variable == Variable::VARIABLES_COUNT || VariableDefiner::getInstance().getDatatype(rule->variable) == VariableDatatype::DT_STRING) {
+                        debugPrintf(true, "ERROR: rule %i, invalid variable", index);
+                    } else if (!VariableRules::parseOperator(item["op"].as<const char *>(), &(rule->op))) {
+                        debugPrintf(true, "ERROR: rule %i, invalid operator", index);
+                    } else if (rule->target == Variable::VARIABLES_COUNT && !item["set"].isNull()) {
+                        debugPrintf(true, "ERROR: rule %i, invalid target", index);
+                    } else if (rule->target != Variable::VARIABLES_COUNT && (VariableDefiner::getInstance().getDefinition(rule->target)->mode != VariableMode::MD_READWRITE ||
+                                                                              VariableDefiner::getInstance().getDatatype(rule->target) == VariableDatatype::DT_STRING)) {
+                        debugPrintf(true, "ERROR: rule %i, target not writable", index);
+                    } else {
+                        rulesCount++;
+                    }
+                    index++;
+                }
+            }
+            rulesFile.close();
+        }
+    }
+    LittleFS.end();
+}
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#ifndef VARIABLE_RULES_H
+#define VARIABLE_RULES_H
+
+#include "../incl/include_all_core.h"
+
+#ifdef USE_VARIABLE_RULES
+
+#include "../solartracer/SolarTracer.h"
+
+#define VARIABLE_RULES_PERSISTENCE "/rules.json"
+
+#ifndef VARIABLE_RULES_MAX
+#define VARIABLE_RULES_MAX 16
+#endif
+
+#define VARIABLE_RULES_ALARM_LENGTH 48
+
+typedef enum {
+    RO_LT,
+    RO_LE,
+    RO_GT,
+    RO_GE,
+    RO_EQ,
+    RO_NE
+} VariableRuleOperator;
+
+/**
+ * Threshold on a variable, with the write and/or the alarm to trigger when it is crossed
+ */
+struct VariableRule {
+        Variable variable;
+        VariableRuleOperator op;
+        float threshold;
+        // the rule is re-armed once the value is back past threshold +/- hysteresis
+        float hysteresis;
+        // VARIABLES_COUNT: nothing to write
+        Variable target;
+        float targetValue;
+        // empty: no alarm
+        char alarm[VARIABLE_RULES_ALARM_LENGTH];
+        bool active;
+        // next rule on the same variable, VARIABLE_RULES_MAX if last
+        uint8_t next;
+};
+
+/**
+ * Threshold rules evaluated on the board, without a round trip through a server.
+ *
+ * Rules are read from VARIABLE_RULES_PERSISTENCE, a JSON array as:
+ * [{"if":"BATTERY_SOC","op":"<","value":20,"hyst":5,"set":"LOAD_MANUAL_ONOFF","to":0,"alarm":"Battery low"}]
+ * Each change of a variable only checks the rules on that variable. A rule fires
+ * once when its condition becomes true, actions are run by apply() after the
+ * tracer update, so they keep working while the servers are unreachable.
+ * Writes and alarms are therefore delayed by up to CONTROLLER_UPDATE_MS_PERIOD.
+ * Alarms are sent to MQTT_ALARM_TOPIC and, with Blynk 2.0 only (USE_BLYNK_2), as the BLYNK_ALARM_EVENT event.
+ */
+class VariableRules {
+    public:
+        static void setup(SolarTracer *tracer);
+
+        /**
+         * Run the actions of the rules fired since the last call, called after each tracer update
+         */
+        static void apply();
+
+    private:
+        static SolarTracer *tracer;
+
+        static void onVariableChanged(Variable variable, const void *oldValue, const void *newValue);
+
+        static bool isMatching(VariableRuleOperator op, float value, float threshold);
+
+        static bool parseOperator(const char *text, VariableRuleOperator *op);
+
+        static void load();
+};
+
+#endif
+
+#endif
@@ -60,6 +60,12 @@ class WifiManagerSTB {
                 Environment::getData()->serialDebug ? "type=\"checkbox\" checked" : "type=\"checkbox\"");
             wifiManager.addParameter(&customDebug);
 
+            WiFiManagerParameter customSyncDisabled(CONFIG_SYNC_DISABLED, "Disabled syncs (blynk,mqtt,mqtt-ha)", Environment::getData()->syncDisabled, CONFIG_SYNC_DISABLED_LEN);
+            wifiManager.addParameter(&customSyncDisabled);
+
+            WiFiManagerParameter customPublishPolicy(CONFIG_PUBLISH_POLICY, "Publish policies (PV_POWER:5:10:300,BATTERY_VOLTAGE:1%)", Environment::getData()->publishPolicy, CONFIG_PUBLISH_POLICY_LEN);
+            wifiManager.addParameter(&customPublishPolicy);
+
             WiFiManagerParameter customWIFIText("<p><b>WIFI:</b></p>");
             wifiManager.addParameter(&customWIFIText);
 
@@ -173,6 +179,8 @@ class WifiManagerSTB {
 
                 DynamicJsonDocument doc(1024);
                 doc[CONFIG_SERIAL_DEBUG] = strcmp(customDebug.getValue(), CONFIG_SERIAL_DEBUG) == 0;
+                doc[CONFIG_SYNC_DISABLED] = customSyncDisabled.getValue();
+                doc[CONFIG_PUBLISH_POLICY] = customPublishPolicy.getValue();
                 doc[CONFIG_WIFI_SSID] = WiFi.SSID();
                 doc[CONFIG_WIFI_PASSWORD] = WiFi.psk();
 
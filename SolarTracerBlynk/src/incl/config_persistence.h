@@ -26,6 +26,12 @@
 //settings
 #define CONFIG_SERIAL_DEBUG "debug"
 
+#define CONFIG_SYNC_DISABLED "syncOff"
+#define CONFIG_SYNC_DISABLED_LEN 31
+
+#define CONFIG_PUBLISH_POLICY "pubPolicy"
+#define CONFIG_PUBLISH_POLICY_LEN 95
+
 #define CONFIG_WIFI_SSID "ssid"
 #define CONFIG_WIFI_SSID_LEN 20
 
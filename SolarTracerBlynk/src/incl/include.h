@@ -32,6 +32,7 @@
 // INCL main components
 #include "../core/datetime.h"
 #include "../core/Controller.h"
+#include "../core/SyncRegistry.h"
 // INCL optional features
 #include "include_all_feature.h"
 
@@ -67,7 +68,7 @@
 #endif
 
 // DIRECTIVE VALIDATION FOR SOLAR TRACER
-#if !defined(USE_SERIAL_STREAM) && (SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_A | SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_B | SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_TRITON | SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_XTRA)
+#if !defined(USE_SERIAL_STREAM) && (SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_A | SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_B | SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_TRITON | SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_XTRA | SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_AUTO)
 #error You must enable USE_SERIAL_STREAM !
 #endif
 
@@ -28,269 +28,332 @@
  * 
  */
 #ifndef vPIN_PV_POWER
-#define vPIN_PV_POWER_DF nullptr
+#define vPIN_PV_POWER_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_PV_POWER_DF new uint8_t(vPIN_PV_POWER)
+#define vPIN_PV_POWER_DF vPIN_PV_POWER
 #endif
 #ifndef vPIN_PV_CURRENT
-#define vPIN_PV_CURRENT_DF nullptr
+#define vPIN_PV_CURRENT_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_PV_CURRENT_DF new uint8_t(vPIN_PV_CURRENT)
+#define vPIN_PV_CURRENT_DF vPIN_PV_CURRENT
 #endif
 #ifndef vPIN_PV_VOLTAGE
-#define vPIN_PV_VOLTAGE_DF nullptr
+#define vPIN_PV_VOLTAGE_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_PV_VOLTAGE_DF new uint8_t(vPIN_PV_VOLTAGE)
+#define vPIN_PV_VOLTAGE_DF vPIN_PV_VOLTAGE
 #endif
 #ifndef vPIN_LOAD_CURRENT
-#define vPIN_LOAD_CURRENT_DF nullptr
+#define vPIN_LOAD_CURRENT_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_LOAD_CURRENT_DF new uint8_t(vPIN_LOAD_CURRENT)
+#define vPIN_LOAD_CURRENT_DF vPIN_LOAD_CURRENT
 #endif
 #ifndef vPIN_LOAD_POWER
-#define vPIN_LOAD_POWER_DF nullptr
+#define vPIN_LOAD_POWER_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_LOAD_POWER_DF new uint8_t(vPIN_LOAD_POWER)
+#define vPIN_LOAD_POWER_DF vPIN_LOAD_POWER
 #endif
 #ifndef vPIN_BATT_TEMP
-#define vPIN_BATT_TEMP_DF nullptr
+#define vPIN_BATT_TEMP_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATT_TEMP_DF new uint8_t(vPIN_BATT_TEMP)
+#define vPIN_BATT_TEMP_DF vPIN_BATT_TEMP
 #endif
 #ifndef vPIN_BATT_VOLTAGE
-#define vPIN_BATT_VOLTAGE_DF nullptr
+#define vPIN_BATT_VOLTAGE_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATT_VOLTAGE_DF new uint8_t(vPIN_BATT_VOLTAGE)
+#define vPIN_BATT_VOLTAGE_DF vPIN_BATT_VOLTAGE
 #endif
 #ifndef vPIN_BATT_REMAIN
-#define vPIN_BATT_REMAIN_DF nullptr
+#define vPIN_BATT_REMAIN_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATT_REMAIN_DF new uint8_t(vPIN_BATT_REMAIN)
+#define vPIN_BATT_REMAIN_DF vPIN_BATT_REMAIN
 #endif
 #ifndef vPIN_CONTROLLER_TEMP
-#define vPIN_CONTROLLER_TEMP_DF nullptr
+#define vPIN_CONTROLLER_TEMP_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_CONTROLLER_TEMP_DF new uint8_t(vPIN_CONTROLLER_TEMP)
+#define vPIN_CONTROLLER_TEMP_DF vPIN_CONTROLLER_TEMP
 #endif
 #ifndef vPIN_BATTERY_CHARGE_CURRENT
-#define vPIN_BATTERY_CHARGE_CURRENT_DF nullptr
+#define vPIN_BATTERY_CHARGE_CURRENT_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_CHARGE_CURRENT_DF new uint8_t(vPIN_BATTERY_CHARGE_CURRENT)
+#define vPIN_BATTERY_CHARGE_CURRENT_DF vPIN_BATTERY_CHARGE_CURRENT
 #endif
 #ifndef vPIN_BATTERY_CHARGE_POWER
-#define vPIN_BATTERY_CHARGE_POWER_DF nullptr
+#define vPIN_BATTERY_CHARGE_POWER_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_CHARGE_POWER_DF new uint8_t(vPIN_BATTERY_CHARGE_POWER)
+#define vPIN_BATTERY_CHARGE_POWER_DF vPIN_BATTERY_CHARGE_POWER
 #endif
 #ifndef vPIN_BATTERY_OVERALL_CURRENT
-#define vPIN_BATTERY_OVERALL_CURRENT_DF nullptr
+#define vPIN_BATTERY_OVERALL_CURRENT_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_OVERALL_CURRENT_DF new uint8_t(vPIN_BATTERY_OVERALL_CURRENT)
+#define vPIN_BATTERY_OVERALL_CURRENT_DF vPIN_BATTERY_OVERALL_CURRENT
 #endif
 #ifndef vPIN_LOAD_ENABLED
-#define vPIN_LOAD_ENABLED_DF nullptr
+#define vPIN_LOAD_ENABLED_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_LOAD_ENABLED_DF new uint8_t(vPIN_LOAD_ENABLED)
+#define vPIN_LOAD_ENABLED_DF vPIN_LOAD_ENABLED
 #endif
 #ifndef vPIN_CHARGE_DEVICE_ENABLED
-#define vPIN_CHARGE_DEVICE_ENABLED_DF nullptr
+#define vPIN_CHARGE_DEVICE_ENABLED_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_CHARGE_DEVICE_ENABLED_DF new uint8_t(vPIN_CHARGE_DEVICE_ENABLED)
+#define vPIN_CHARGE_DEVICE_ENABLED_DF vPIN_CHARGE_DEVICE_ENABLED
 #endif
 #ifndef vPIN_BATTERY_STATUS_TEXT
-#define vPIN_BATTERY_STATUS_TEXT_DF nullptr
+#define vPIN_BATTERY_STATUS_TEXT_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_STATUS_TEXT_DF new uint8_t(vPIN_BATTERY_STATUS_TEXT)
+#define vPIN_BATTERY_STATUS_TEXT_DF vPIN_BATTERY_STATUS_TEXT
 #endif
 #ifndef vPIN_CHARGING_EQUIPMENT_STATUS_TEXT
-#define vPIN_CHARGING_EQUIPMENT_STATUS_TEXT_DF nullptr
+#define vPIN_CHARGING_EQUIPMENT_STATUS_TEXT_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_CHARGING_EQUIPMENT_STATUS_TEXT_DF new uint8_t(vPIN_CHARGING_EQUIPMENT_STATUS_TEXT)
+#define vPIN_CHARGING_EQUIPMENT_STATUS_TEXT_DF vPIN_CHARGING_EQUIPMENT_STATUS_TEXT
 #endif
 #ifndef vPIN_DISCHARGING_EQUIPMENT_STATUS_TEXT
-#define vPIN_DISCHARGING_EQUIPMENT_STATUS_TEXT_DF nullptr
+#define vPIN_DISCHARGING_EQUIPMENT_STATUS_TEXT_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_DISCHARGING_EQUIPMENT_STATUS_TEXT_DF new uint8_t(vPIN_DISCHARGING_EQUIPMENT_STATUS_TEXT)
+#define vPIN_DISCHARGING_EQUIPMENT_STATUS_TEXT_DF vPIN_DISCHARGING_EQUIPMENT_STATUS_TEXT
 #endif
 #ifndef vPIN_CONTROLLER_HEATSINK_TEMP
-#define vPIN_CONTROLLER_HEATSINK_TEMP_DF nullptr
+#define vPIN_CONTROLLER_HEATSINK_TEMP_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_CONTROLLER_HEATSINK_TEMP_DF new uint8_t(vPIN_CONTROLLER_HEATSINK_TEMP)
+#define vPIN_CONTROLLER_HEATSINK_TEMP_DF vPIN_CONTROLLER_HEATSINK_TEMP
 #endif
 #ifndef vPIN_STAT_ENERGY_GENERATED_TODAY
-#define vPIN_STAT_ENERGY_GENERATED_TODAY_DF nullptr
+#define vPIN_STAT_ENERGY_GENERATED_TODAY_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_STAT_ENERGY_GENERATED_TODAY_DF new uint8_t(vPIN_STAT_ENERGY_GENERATED_TODAY)
+#define vPIN_STAT_ENERGY_GENERATED_TODAY_DF vPIN_STAT_ENERGY_GENERATED_TODAY
 #endif
 #ifndef vPIN_STAT_ENERGY_GENERATED_THIS_MONTH
-#define vPIN_STAT_ENERGY_GENERATED_THIS_MONTH_DF nullptr
+#define vPIN_STAT_ENERGY_GENERATED_THIS_MONTH_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_STAT_ENERGY_GENERATED_THIS_MONTH_DF new uint8_t(vPIN_STAT_ENERGY_GENERATED_THIS_MONTH)
+#define vPIN_STAT_ENERGY_GENERATED_THIS_MONTH_DF vPIN_STAT_ENERGY_GENERATED_THIS_MONTH
 #endif
 #ifndef vPIN_STAT_ENERGY_GENERATED_THIS_YEAR
-#define vPIN_STAT_ENERGY_GENERATED_THIS_YEAR_DF nullptr
+#define vPIN_STAT_ENERGY_GENERATED_THIS_YEAR_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_STAT_ENERGY_GENERATED_THIS_YEAR_DF new uint8_t(vPIN_STAT_ENERGY_GENERATED_THIS_YEAR)
+#define vPIN_STAT_ENERGY_GENERATED_THIS_YEAR_DF vPIN_STAT_ENERGY_GENERATED_THIS_YEAR
 #endif
 #ifndef vPIN_STAT_ENERGY_GENERATED_TOTAL
-#define vPIN_STAT_ENERGY_GENERATED_TOTAL_DF nullptr
+#define vPIN_STAT_ENERGY_GENERATED_TOTAL_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_STAT_ENERGY_GENERATED_TOTAL_DF new uint8_t(vPIN_STAT_ENERGY_GENERATED_TOTAL)
+#define vPIN_STAT_ENERGY_GENERATED_TOTAL_DF vPIN_STAT_ENERGY_GENERATED_TOTAL
 #endif
 #ifndef vPIN_MIN_BATTERY_VOLTAGE_TODAY
-#define vPIN_MIN_BATTERY_VOLTAGE_TODAY_DF nullptr
+#define vPIN_MIN_BATTERY_VOLTAGE_TODAY_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_MIN_BATTERY_VOLTAGE_TODAY_DF new uint8_t(vPIN_MIN_BATTERY_VOLTAGE_TODAY)
+#define vPIN_MIN_BATTERY_VOLTAGE_TODAY_DF vPIN_MIN_BATTERY_VOLTAGE_TODAY
 #endif
 #ifndef vPIN_MAX_BATTERY_VOLTAGE_TODAY
-#define vPIN_MAX_BATTERY_VOLTAGE_TODAY_DF nullptr
+#define vPIN_MAX_BATTERY_VOLTAGE_TODAY_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_MAX_BATTERY_VOLTAGE_TODAY_DF new uint8_t(vPIN_MAX_BATTERY_VOLTAGE_TODAY)
+#define vPIN_MAX_BATTERY_VOLTAGE_TODAY_DF vPIN_MAX_BATTERY_VOLTAGE_TODAY
 #endif
 #ifndef vPIN_MIN_PV_VOLTAGE_TODAY
-#define vPIN_MIN_PV_VOLTAGE_TODAY_DF nullptr
+#define vPIN_MIN_PV_VOLTAGE_TODAY_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_MIN_PV_VOLTAGE_TODAY_DF new uint8_t(vPIN_MIN_PV_VOLTAGE_TODAY)
+#define vPIN_MIN_PV_VOLTAGE_TODAY_DF vPIN_MIN_PV_VOLTAGE_TODAY
 #endif
 #ifndef vPIN_MAX_PV_VOLTAGE_TODAY
-#define vPIN_MAX_PV_VOLTAGE_TODAY_DF nullptr
+#define vPIN_MAX_PV_VOLTAGE_TODAY_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_MAX_PV_VOLTAGE_TODAY_DF new uint8_t(vPIN_MAX_PV_VOLTAGE_TODAY)
+#define vPIN_MAX_PV_VOLTAGE_TODAY_DF vPIN_MAX_PV_VOLTAGE_TODAY
 #endif
 #ifndef vPIN_BATTERY_BOOST_VOLTAGE
-#define vPIN_BATTERY_BOOST_VOLTAGE_DF nullptr
+#define vPIN_BATTERY_BOOST_VOLTAGE_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_BOOST_VOLTAGE_DF new uint8_t(vPIN_BATTERY_BOOST_VOLTAGE)
+#define vPIN_BATTERY_BOOST_VOLTAGE_DF vPIN_BATTERY_BOOST_VOLTAGE
 #endif
 #ifndef vPIN_BATTERY_EQUALIZATION_VOLTAGE
-#define vPIN_BATTERY_EQUALIZATION_VOLTAGE_DF nullptr
+#define vPIN_BATTERY_EQUALIZATION_VOLTAGE_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_EQUALIZATION_VOLTAGE_DF new uint8_t(vPIN_BATTERY_EQUALIZATION_VOLTAGE)
+#define vPIN_BATTERY_EQUALIZATION_VOLTAGE_DF vPIN_BATTERY_EQUALIZATION_VOLTAGE
 #endif
 #ifndef vPIN_BATTERY_FLOAT_VOLTAGE
-#define vPIN_BATTERY_FLOAT_VOLTAGE_DF nullptr
+#define vPIN_BATTERY_FLOAT_VOLTAGE_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_FLOAT_VOLTAGE_DF new uint8_t(vPIN_BATTERY_FLOAT_VOLTAGE)
+#define vPIN_BATTERY_FLOAT_VOLTAGE_DF vPIN_BATTERY_FLOAT_VOLTAGE
 #endif
 #ifndef vPIN_BATTERY_FLOAT_MIN_VOLTAGE
-#define vPIN_BATTERY_FLOAT_MIN_VOLTAGE_DF nullptr
+#define vPIN_BATTERY_FLOAT_MIN_VOLTAGE_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_FLOAT_MIN_VOLTAGE_DF new uint8_t(vPIN_BATTERY_FLOAT_MIN_VOLTAGE)
+#define vPIN_BATTERY_FLOAT_MIN_VOLTAGE_DF vPIN_BATTERY_FLOAT_MIN_VOLTAGE
 #endif
 #ifndef vPIN_BATTERY_CHARGING_LIMIT_VOLTAGE
-#define vPIN_BATTERY_CHARGING_LIMIT_VOLTAGE_DF nullptr
+#define vPIN_BATTERY_CHARGING_LIMIT_VOLTAGE_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_CHARGING_LIMIT_VOLTAGE_DF new uint8_t(vPIN_BATTERY_CHARGING_LIMIT_VOLTAGE)
+#define vPIN_BATTERY_CHARGING_LIMIT_VOLTAGE_DF vPIN_BATTERY_CHARGING_LIMIT_VOLTAGE
 #endif
 #ifndef vPIN_BATTERY_DISCHARGING_LIMIT_VOLTAGE
-#define vPIN_BATTERY_DISCHARGING_LIMIT_VOLTAGE_DF nullptr
+#define vPIN_BATTERY_DISCHARGING_LIMIT_VOLTAGE_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_DISCHARGING_LIMIT_VOLTAGE_DF new uint8_t(vPIN_BATTERY_DISCHARGING_LIMIT_VOLTAGE)
+#define vPIN_BATTERY_DISCHARGING_LIMIT_VOLTAGE_DF vPIN_BATTERY_DISCHARGING_LIMIT_VOLTAGE
 #endif
 #ifndef vPIN_BATTERY_LOW_VOLTAGE_DISCONNECT
-#define vPIN_BATTERY_LOW_VOLTAGE_DISCONNECT_DF nullptr
+#define vPIN_BATTERY_LOW_VOLTAGE_DISCONNECT_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_LOW_VOLTAGE_DISCONNECT_DF new uint8_t(vPIN_BATTERY_LOW_VOLTAGE_DISCONNECT)
+#define vPIN_BATTERY_LOW_VOLTAGE_DISCONNECT_DF vPIN_BATTERY_LOW_VOLTAGE_DISCONNECT
 #endif
 #ifndef vPIN_BATTERY_LOW_VOLTAGE_RECONNECT
-#define vPIN_BATTERY_LOW_VOLTAGE_RECONNECT_DF nullptr
+#define vPIN_BATTERY_LOW_VOLTAGE_RECONNECT_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_LOW_VOLTAGE_RECONNECT_DF new uint8_t(vPIN_BATTERY_LOW_VOLTAGE_RECONNECT)
+#define vPIN_BATTERY_LOW_VOLTAGE_RECONNECT_DF vPIN_BATTERY_LOW_VOLTAGE_RECONNECT
 #endif
 #ifndef vPIN_BATTERY_OVER_VOLTAGE_DISCONNECT
-#define vPIN_BATTERY_OVER_VOLTAGE_DISCONNECT_DF nullptr
+#define vPIN_BATTERY_OVER_VOLTAGE_DISCONNECT_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_OVER_VOLTAGE_DISCONNECT_DF new uint8_t(vPIN_BATTERY_OVER_VOLTAGE_DISCONNECT)
+#define vPIN_BATTERY_OVER_VOLTAGE_DISCONNECT_DF vPIN_BATTERY_OVER_VOLTAGE_DISCONNECT
 #endif
 #ifndef vPIN_BATTERY_OVER_VOLTAGE_RECONNECT
-#define vPIN_BATTERY_OVER_VOLTAGE_RECONNECT_DF nullptr
+#define vPIN_BATTERY_OVER_VOLTAGE_RECONNECT_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_OVER_VOLTAGE_RECONNECT_DF new uint8_t(vPIN_BATTERY_OVER_VOLTAGE_RECONNECT)
+#define vPIN_BATTERY_OVER_VOLTAGE_RECONNECT_DF vPIN_BATTERY_OVER_VOLTAGE_RECONNECT
 #endif
 #ifndef vPIN_BATTERY_UNDER_VOLTAGE_RESET
-#define vPIN_BATTERY_UNDER_VOLTAGE_RESET_DF nullptr
+#define vPIN_BATTERY_UNDER_VOLTAGE_RESET_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_UNDER_VOLTAGE_RESET_DF new uint8_t(vPIN_BATTERY_UNDER_VOLTAGE_RESET)
+#define vPIN_BATTERY_UNDER_VOLTAGE_RESET_DF vPIN_BATTERY_UNDER_VOLTAGE_RESET
 #endif
 #ifndef vPIN_BATTERY_UNDER_VOLTAGE_SET
-#define vPIN_BATTERY_UNDER_VOLTAGE_SET_DF nullptr
+#define vPIN_BATTERY_UNDER_VOLTAGE_SET_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_UNDER_VOLTAGE_SET_DF new uint8_t(vPIN_BATTERY_UNDER_VOLTAGE_SET)
+#define vPIN_BATTERY_UNDER_VOLTAGE_SET_DF vPIN_BATTERY_UNDER_VOLTAGE_SET
 #endif
 #ifndef vPIN_INTERNAL_STATUS
-#define vPIN_INTERNAL_STATUS_DF nullptr
+#define vPIN_INTERNAL_STATUS_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_INTERNAL_STATUS_DF new uint8_t(vPIN_INTERNAL_STATUS)
+#define vPIN_INTERNAL_STATUS_DF vPIN_INTERNAL_STATUS
 #endif
 #ifndef vPIN_INTERNAL_DEBUG_TERMINAL
-#define vPIN_INTERNAL_DEBUG_TERMINAL_DF nullptr
+#define vPIN_INTERNAL_DEBUG_TERMINAL_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_INTERNAL_DEBUG_TERMINAL_DF new uint8_t(vPIN_INTERNAL_DEBUG_TERMINAL)
+#define vPIN_INTERNAL_DEBUG_TERMINAL_DF vPIN_INTERNAL_DEBUG_TERMINAL
 #endif
 #ifndef vPIN_UPDATE_CONTROLLER_DATETIME
-#define vPIN_UPDATE_CONTROLLER_DATETIME_DF nullptr
+#define vPIN_UPDATE_CONTROLLER_DATETIME_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_UPDATE_CONTROLLER_DATETIME_DF new uint8_t(vPIN_UPDATE_CONTROLLER_DATETIME)
+#define vPIN_UPDATE_CONTROLLER_DATETIME_DF vPIN_UPDATE_CONTROLLER_DATETIME
 #endif
 #ifndef vPIN_UPDATE_ALL_CONTROLLER_DATA
-#define vPIN_UPDATE_ALL_CONTROLLER_DATA_DF nullptr
+#define vPIN_UPDATE_ALL_CONTROLLER_DATA_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_UPDATE_ALL_CONTROLLER_DATA_DF new uint8_t(vPIN_UPDATE_ALL_CONTROLLER_DATA)
+#define vPIN_UPDATE_ALL_CONTROLLER_DATA_DF vPIN_UPDATE_ALL_CONTROLLER_DATA
 #endif
 #ifndef vPIN_BATTERY_RATED_VOLTAGE
-#define vPIN_BATTERY_RATED_VOLTAGE_DF nullptr
+#define vPIN_BATTERY_RATED_VOLTAGE_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_RATED_VOLTAGE_DF new uint8_t(vPIN_BATTERY_RATED_VOLTAGE)
+#define vPIN_BATTERY_RATED_VOLTAGE_DF vPIN_BATTERY_RATED_VOLTAGE
 #endif
 #ifndef vPIN_BATTERY_TYPE
-#define vPIN_BATTERY_TYPE_DF nullptr
+#define vPIN_BATTERY_TYPE_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_TYPE_DF new uint8_t(vPIN_BATTERY_TYPE)
+#define vPIN_BATTERY_TYPE_DF vPIN_BATTERY_TYPE
 #endif
 #ifndef vPIN_BATTERY_CAPACITY
-#define vPIN_BATTERY_CAPACITY_DF nullptr
+#define vPIN_BATTERY_CAPACITY_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_CAPACITY_DF new uint8_t(vPIN_BATTERY_CAPACITY)
+#define vPIN_BATTERY_CAPACITY_DF vPIN_BATTERY_CAPACITY
 #endif
 #ifndef vPIN_BATTERY_EQUALIZATION_DURATION
-#define vPIN_BATTERY_EQUALIZATION_DURATION_DF nullptr
+#define vPIN_BATTERY_EQUALIZATION_DURATION_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_EQUALIZATION_DURATION_DF new uint8_t(vPIN_BATTERY_EQUALIZATION_DURATION)
+#define vPIN_BATTERY_EQUALIZATION_DURATION_DF vPIN_BATTERY_EQUALIZATION_DURATION
 #endif
 #ifndef vPIN_BATTERY_BOOST_DURATION
-#define vPIN_BATTERY_BOOST_DURATION_DF nullptr
+#define vPIN_BATTERY_BOOST_DURATION_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_BOOST_DURATION_DF new uint8_t(vPIN_BATTERY_BOOST_DURATION)
+#define vPIN_BATTERY_BOOST_DURATION_DF vPIN_BATTERY_BOOST_DURATION
 #endif
 #ifndef vPIN_BATTERY_TEMPERATURE_COMPENSATION_COEFF
-#define vPIN_BATTERY_TEMPERATURE_COMPENSATION_COEFF_DF nullptr
+#define vPIN_BATTERY_TEMPERATURE_COMPENSATION_COEFF_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_TEMPERATURE_COMPENSATION_COEFF_DF new uint8_t(vPIN_BATTERY_TEMPERATURE_COMPENSATION_COEFF)
+#define vPIN_BATTERY_TEMPERATURE_COMPENSATION_COEFF_DF vPIN_BATTERY_TEMPERATURE_COMPENSATION_COEFF
 #endif
 #ifndef vPIN_BATTERY_MANAGEMENT_MODE
-#define vPIN_BATTERY_MANAGEMENT_MODE_DF nullptr
+#define vPIN_BATTERY_MANAGEMENT_MODE_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_BATTERY_MANAGEMENT_MODE_DF new uint8_t(vPIN_BATTERY_MANAGEMENT_MODE)
+#define vPIN_BATTERY_MANAGEMENT_MODE_DF vPIN_BATTERY_MANAGEMENT_MODE
 #endif
 #ifndef vPIN_STAT_ENERGY_CONSUMED_TODAY
-#define vPIN_STAT_ENERGY_CONSUMED_TODAY_DF nullptr
+#define vPIN_STAT_ENERGY_CONSUMED_TODAY_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_STAT_ENERGY_CONSUMED_TODAY_DF new uint8_t(vPIN_STAT_ENERGY_CONSUMED_TODAY)
+#define vPIN_STAT_ENERGY_CONSUMED_TODAY_DF vPIN_STAT_ENERGY_CONSUMED_TODAY
 #endif
 #ifndef vPIN_STAT_ENERGY_CONSUMED_THIS_MONTH
-#define vPIN_STAT_ENERGY_CONSUMED_THIS_MONTH_DF nullptr
+#define vPIN_STAT_ENERGY_CONSUMED_THIS_MONTH_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_STAT_ENERGY_CONSUMED_THIS_MONTH_DF new uint8_t(vPIN_STAT_ENERGY_CONSUMED_THIS_MONTH)
+#define vPIN_STAT_ENERGY_CONSUMED_THIS_MONTH_DF vPIN_STAT_ENERGY_CONSUMED_THIS_MONTH
 #endif
 #ifndef vPIN_STAT_ENERGY_CONSUMED_THIS_YEAR
-#define vPIN_STAT_ENERGY_CONSUMED_THIS_YEAR_DF nullptr
+#define vPIN_STAT_ENERGY_CONSUMED_THIS_YEAR_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_STAT_ENERGY_CONSUMED_THIS_YEAR_DF new uint8_t(vPIN_STAT_ENERGY_CONSUMED_THIS_YEAR)
+#define vPIN_STAT_ENERGY_CONSUMED_THIS_YEAR_DF vPIN_STAT_ENERGY_CONSUMED_THIS_YEAR
 #endif
 #ifndef vPIN_STAT_ENERGY_CONSUMED_TOTAL
-#define vPIN_STAT_ENERGY_CONSUMED_TOTAL_DF nullptr
+#define vPIN_STAT_ENERGY_CONSUMED_TOTAL_DF VARIABLE_NO_BLYNK_VPIN
 #else
-#define vPIN_STAT_ENERGY_CONSUMED_TOTAL_DF new uint8_t(vPIN_STAT_ENERGY_CONSUMED_TOTAL)
+#define vPIN_STAT_ENERGY_CONSUMED_TOTAL_DF vPIN_STAT_ENERGY_CONSUMED_TOTAL
+#endif
+#ifndef vPIN_PV_RATED_POWER
+#define vPIN_PV_RATED_POWER_DF VARIABLE_NO_BLYNK_VPIN
+#else
+#define vPIN_PV_RATED_POWER_DF vPIN_PV_RATED_POWER
+#endif
+#ifndef vPIN_CHARGING_EFFICIENCY
+#define vPIN_CHARGING_EFFICIENCY_DF VARIABLE_NO_BLYNK_VPIN
+#else
+#define vPIN_CHARGING_EFFICIENCY_DF vPIN_CHARGING_EFFICIENCY
+#endif
+#ifndef vPIN_BATTERY_NET_POWER
+#define vPIN_BATTERY_NET_POWER_DF VARIABLE_NO_BLYNK_VPIN
+#else
+#define vPIN_BATTERY_NET_POWER_DF vPIN_BATTERY_NET_POWER
+#endif
+#ifndef vPIN_LOAD_SHARE
+#define vPIN_LOAD_SHARE_DF VARIABLE_NO_BLYNK_VPIN
+#else
+#define vPIN_LOAD_SHARE_DF vPIN_LOAD_SHARE
+#endif
+#ifndef vPIN_PV_UTILISATION
+#define vPIN_PV_UTILISATION_DF VARIABLE_NO_BLYNK_VPIN
+#else
+#define vPIN_PV_UTILISATION_DF vPIN_PV_UTILISATION
+#endif
+#ifndef vPIN_PV_POWER_MINUTE_AVG
+#define vPIN_PV_POWER_MINUTE_AVG_DF VARIABLE_NO_BLYNK_VPIN
+#else
+#define vPIN_PV_POWER_MINUTE_AVG_DF vPIN_PV_POWER_MINUTE_AVG
+#endif
+#ifndef vPIN_PV_POWER_HOUR_MAX
+#define vPIN_PV_POWER_HOUR_MAX_DF VARIABLE_NO_BLYNK_VPIN
+#else
+#define vPIN_PV_POWER_HOUR_MAX_DF vPIN_PV_POWER_HOUR_MAX
+#endif
+#ifndef vPIN_PV_ENERGY_HOUR
+#define vPIN_PV_ENERGY_HOUR_DF VARIABLE_NO_BLYNK_VPIN
+#else
+#define vPIN_PV_ENERGY_HOUR_DF vPIN_PV_ENERGY_HOUR
+#endif
+#ifndef vPIN_LOAD_ENERGY_HOUR
+#define vPIN_LOAD_ENERGY_HOUR_DF VARIABLE_NO_BLYNK_VPIN
+#else
+#define vPIN_LOAD_ENERGY_HOUR_DF vPIN_LOAD_ENERGY_HOUR
+#endif
+#ifndef vPIN_BATTERY_VOLTAGE_DAY_MIN
+#define vPIN_BATTERY_VOLTAGE_DAY_MIN_DF VARIABLE_NO_BLYNK_VPIN
+#else
+#define vPIN_BATTERY_VOLTAGE_DAY_MIN_DF vPIN_BATTERY_VOLTAGE_DAY_MIN
+#endif
+#ifndef vPIN_BATTERY_VOLTAGE_DAY_MAX
+#define vPIN_BATTERY_VOLTAGE_DAY_MAX_DF VARIABLE_NO_BLYNK_VPIN
+#else
+#define vPIN_BATTERY_VOLTAGE_DAY_MAX_DF vPIN_BATTERY_VOLTAGE_DAY_MAX
+#endif
+#ifndef vPIN_PV_ENERGY_DAY
+#define vPIN_PV_ENERGY_DAY_DF VARIABLE_NO_BLYNK_VPIN
+#else
+#define vPIN_PV_ENERGY_DAY_DF vPIN_PV_ENERGY_DAY
+#endif
+#ifndef vPIN_LOAD_ENERGY_DAY
+#define vPIN_LOAD_ENERGY_DAY_DF VARIABLE_NO_BLYNK_VPIN
+#else
+#define vPIN_LOAD_ENERGY_DAY_DF vPIN_LOAD_ENERGY_DAY
 #endif
-
-
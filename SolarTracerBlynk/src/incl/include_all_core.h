@@ -56,6 +56,11 @@
 #define SOLAR_TRACER_MODEL DUMMY_SOLAR_TRACER
 #endif
 
+// raw mqtt topics: alone or along with home assistant, through its broker connection
+#if defined(USE_MQTT) && (!defined(USE_MQTT_HOME_ASSISTANT) || defined(USE_MQTT_HOME_ASSISTANT_RAW_TOPICS))
+#define USE_MQTT_RAW_TOPICS
+#endif
+
 
 
 /**
@@ -72,7 +77,7 @@
 /**
  * Conditional includes depending on the SOLAR CHARGE CONTROLLER
  */
-#if (SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_A | SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_B | SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_TRITON | SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_XTRA)
+#if (SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_A | SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_B | SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_TRITON | SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_XTRA | SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_AUTO)
 #include "../solartracer/epever/epever_config.h"
 #elif (SOLAR_TRACER_MODEL == DUMMY_SOLAR_TRACER)
 #else
@@ -30,6 +30,18 @@
   #include "../solartracer/overwrite/LoadCurrentOverwrite.h"
 #endif
 
+#ifdef USE_VARIABLE_HISTORY
+  #include "../feature/VariableHistory.h"
+#endif
+
+#ifdef USE_VARIABLE_ROLLUP
+  #include "../feature/VariableRollup.h"
+#endif
+
+#ifdef USE_VARIABLE_RULES
+  #include "../feature/VariableRules.h"
+#endif
+
 #ifdef USE_STATUS_LED
 #include "../feature/status_led.h"
 #endif
@@ -45,7 +57,8 @@
 #if defined USE_BLYNK
 #include "../feature/BlynkSync.h"
 #endif
-#if defined(USE_MQTT) && !defined(USE_MQTT_HOME_ASSISTANT)
+
+#if defined(USE_MQTT_RAW_TOPICS)
 #include "../feature/MqttSync.h"
 #endif
 #if defined(USE_MQTT) && defined(USE_MQTT_HOME_ASSISTANT)
@@ -40,8 +40,13 @@
 
 #include <SimpleTimer.h>
 
-#ifdef USE_DOUBLE_RESET_TRIGGER
+// features storing files
+#if defined(USE_DOUBLE_RESET_TRIGGER) || defined(USE_WIFI_AP_CONFIGURATION) || defined(USE_SYNC_OUTBOX) || defined(USE_VARIABLE_ROLLUP) || \
+    defined(USE_EXTERNAL_HEAVY_LOAD_CURRENT_METER) || defined(USE_VARIABLE_RULES)
 #include <LittleFS.h>
+#endif
+
+#ifdef USE_DOUBLE_RESET_TRIGGER
 #define ESP_DRD_USE_LITTLEFS true
 #include <ESP_DoubleResetDetector.h>
 #endif
@@ -52,7 +57,6 @@
 
 #include <ArduinoJson.h>
 #if defined USE_WIFI_AP_CONFIGURATION
-#include <LittleFS.h>
 // disable WM all logs
 // #define WM_NODEBUG
 #include <WiFiManager.h>
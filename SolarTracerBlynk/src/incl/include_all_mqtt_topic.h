@@ -29,6 +29,9 @@
  * 
  */
 
+#ifndef MQTT_TOPIC_ROOT
+#define MQTT_TOPIC_ROOT ""
+#endif
 
 #ifndef MQTT_TOPIC_PV_POWER
 #define MQTT_TOPIC_PV_POWER_DF nullptr
@@ -294,4 +297,69 @@
 #define MQTT_TOPIC_STAT_ENERGY_CONSUMED_TOTAL_DF nullptr
 #else
 #define MQTT_TOPIC_STAT_ENERGY_CONSUMED_TOTAL_DF MQTT_TOPIC_STAT_ENERGY_CONSUMED_TOTAL
-#endif
\ No newline at end of file
+#endif
+#ifndef MQTT_TOPIC_PV_RATED_POWER
+#define MQTT_TOPIC_PV_RATED_POWER_DF nullptr
+#else
+#define MQTT_TOPIC_PV_RATED_POWER_DF MQTT_TOPIC_PV_RATED_POWER
+#endif
+#ifndef MQTT_TOPIC_CHARGING_EFFICIENCY
+#define MQTT_TOPIC_CHARGING_EFFICIENCY_DF nullptr
+#else
+#define MQTT_TOPIC_CHARGING_EFFICIENCY_DF MQTT_TOPIC_CHARGING_EFFICIENCY
+#endif
+#ifndef MQTT_TOPIC_BATTERY_NET_POWER
+#define MQTT_TOPIC_BATTERY_NET_POWER_DF nullptr
+#else
+#define MQTT_TOPIC_BATTERY_NET_POWER_DF MQTT_TOPIC_BATTERY_NET_POWER
+#endif
+#ifndef MQTT_TOPIC_LOAD_SHARE
+#define MQTT_TOPIC_LOAD_SHARE_DF nullptr
+#else
+#define MQTT_TOPIC_LOAD_SHARE_DF MQTT_TOPIC_LOAD_SHARE
+#endif
+#ifndef MQTT_TOPIC_PV_UTILISATION
+#define MQTT_TOPIC_PV_UTILISATION_DF nullptr
+#else
+#define MQTT_TOPIC_PV_UTILISATION_DF MQTT_TOPIC_PV_UTILISATION
+#endif
+#ifndef MQTT_TOPIC_PV_POWER_MINUTE_AVG
+#define MQTT_TOPIC_PV_POWER_MINUTE_AVG_DF nullptr
+#else
+#define MQTT_TOPIC_PV_POWER_MINUTE_AVG_DF MQTT_TOPIC_PV_POWER_MINUTE_AVG
+#endif
+#ifndef MQTT_TOPIC_PV_POWER_HOUR_MAX
+#define MQTT_TOPIC_PV_POWER_HOUR_MAX_DF nullptr
+#else
+#define MQTT_TOPIC_PV_POWER_HOUR_MAX_DF MQTT_TOPIC_PV_POWER_HOUR_MAX
+#endif
+#ifndef MQTT_TOPIC_PV_ENERGY_HOUR
+#define MQTT_TOPIC_PV_ENERGY_HOUR_DF nullptr
+#else
+#define MQTT_TOPIC_PV_ENERGY_HOUR_DF MQTT_TOPIC_PV_ENERGY_HOUR
+#endif
+#ifndef MQTT_TOPIC_LOAD_ENERGY_HOUR
+#define MQTT_TOPIC_LOAD_ENERGY_HOUR_DF nullptr
+#else
+#define MQTT_TOPIC_LOAD_ENERGY_HOUR_DF MQTT_TOPIC_LOAD_ENERGY_HOUR
+#endif
+#ifndef MQTT_TOPIC_BATTERY_VOLTAGE_DAY_MIN
+#define MQTT_TOPIC_BATTERY_VOLTAGE_DAY_MIN_DF nullptr
+#else
+#define MQTT_TOPIC_BATTERY_VOLTAGE_DAY_MIN_DF MQTT_TOPIC_BATTERY_VOLTAGE_DAY_MIN
+#endif
+#ifndef MQTT_TOPIC_BATTERY_VOLTAGE_DAY_MAX
+#define MQTT_TOPIC_BATTERY_VOLTAGE_DAY_MAX_DF nullptr
+#else
+#define MQTT_TOPIC_BATTERY_VOLTAGE_DAY_MAX_DF MQTT_TOPIC_BATTERY_VOLTAGE_DAY_MAX
+#endif
+#ifndef MQTT_TOPIC_PV_ENERGY_DAY
+#define MQTT_TOPIC_PV_ENERGY_DAY_DF nullptr
+#else
+#define MQTT_TOPIC_PV_ENERGY_DAY_DF MQTT_TOPIC_PV_ENERGY_DAY
+#endif
+#ifndef MQTT_TOPIC_LOAD_ENERGY_DAY
+#define MQTT_TOPIC_LOAD_ENERGY_DAY_DF nullptr
+#else
+#define MQTT_TOPIC_LOAD_ENERGY_DAY_DF MQTT_TOPIC_LOAD_ENERGY_DAY
+#endif
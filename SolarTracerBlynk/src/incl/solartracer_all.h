@@ -26,4 +26,5 @@
 #define EPEVER_SOLAR_TRACER_A 0x0001
 #define EPEVER_SOLAR_TRACER_B 0x0002
 #define EPEVER_SOLAR_TRACER_TRITON 0x0003
-#define EPEVER_SOLAR_TRACER_XTRA 0x0004
\ No newline at end of file
+#define EPEVER_SOLAR_TRACER_XTRA 0x0004
+#define EPEVER_SOLAR_TRACER_AUTO 0x0005
\ No newline at end of file
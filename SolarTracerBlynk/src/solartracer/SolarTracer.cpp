@@ -21,36 +21,43 @@
 
 #include "SolarTracer.h"
 
+constexpr uint16_t SolarTracer::variableOffset[];
+
 SolarTracer::SolarTracer() {
-    this->variableDefine = new SolarTracerVariableDefinition *[Variable::VARIABLES_COUNT]();
-    SolarTracerVariableDefinition *value;
-    uint8_t varSize;
-
-    for (uint8_t varIndex = 0; varIndex < Variable::VARIABLES_COUNT; varIndex++) {
-        value = nullptr;
-        if (VariableDefiner::getInstance().isFromScc((Variable)varIndex)) {
-            varSize = VariableDefiner::getInstance().getVariableSize((Variable)varIndex);
-            if (varSize > 0) {
-                value = new SolarTracerVariableDefinition{0, malloc(varSize)};
-            }
-        }
-        this->variableDefine[varIndex] = value;
+    memset(this->firstSubscription, SOLAR_TRACER_NO_SUBSCRIPTION, sizeof(this->firstSubscription));
+
+    memset(this->filterIndex, SOLAR_TRACER_NO_FILTER, sizeof(this->filterIndex));
+    for (uint8_t index = 0; index < FILTERED_VARIABLES_COUNT; index++) {
+        this->filterIndex[VariableDefiner::getInstance().getFilterDefinition(index)->variable] = index;
+        this->resetFilter(index);
     }
 }
 
 void SolarTracer::setVariableEnable(Variable variable, bool enable) {
-    if (variable < Variable::VARIABLES_COUNT && this->variableDefine[variable] != nullptr && this->isVariableEnabled(variable) != enable) {
-        this->variableDefine[variable]->status += enable ? 1 : -1;
+    if (this->isVariableEnabled(variable) == enable) {
+        return;
     }
+    this->setStatus(variable, SOLAR_TRACER_VARIABLE_ENABLED, enable);
+    this->logVariableChange(variable);
+    this->updateDerivedEnable(variable);
 }
 
 bool SolarTracer::isVariableEnabled(Variable variable) {
-    return variable < Variable::VARIABLES_COUNT && this->variableDefine[variable] != nullptr && (this->variableDefine[variable]->status & 1) > 0;
+    return this->isStatusSet(variable, SOLAR_TRACER_VARIABLE_ENABLED);
 }
 
 void SolarTracer::setVariableReadReady(Variable variable, bool enable) {
-    if (variable < Variable::VARIABLES_COUNT && this->isVariableReadReady(variable) != enable) {
-        this->variableDefine[variable]->status += enable ? 2 : -2;
+    if (this->isVariableReadReady(variable) != enable) {
+        this->updateReadReady(variable, enable);
+        this->logVariableChange(variable);
+    }
+}
+
+void SolarTracer::updateReadReady(Variable variable, bool enable) {
+    this->setStatus(variable, SOLAR_TRACER_VARIABLE_READY, enable);
+    if (!enable && this->filterIndex[variable] != SOLAR_TRACER_NO_FILTER) {
+        // the filter restarts from the next value read
+        this->resetFilter(this->filterIndex[variable]);
     }
 }
 
@@ -66,21 +73,24 @@ void SolarTracer::setVariableReadReady(uint8_t count, bool ready, ...) {
 }
 
 bool SolarTracer::isVariableReadReady(Variable variable) {
-    return variable < Variable::VARIABLES_COUNT && (this->variableDefine[variable]->status & 2) > 0;
+    return this->isStatusSet(variable, SOLAR_TRACER_VARIABLE_READY);
 }
 
 bool SolarTracer::isVariableOverWritten(Variable variable) {
-    return variable < Variable::VARIABLES_COUNT && this->variableDefine[variable] != nullptr && (this->variableDefine[variable]->status & 4) > 0;
+    return this->isStatusSet(variable, SOLAR_TRACER_VARIABLE_OVERWRITTEN);
 }
 
 void SolarTracer::setVariableOverWritten(Variable variable, bool enable) {
-    if (variable < Variable::VARIABLES_COUNT && this->isVariableOverWritten(variable) != enable) {
-        this->variableDefine[variable]->status += enable ? 4 : -4;
+    if (this->isVariableOverWritten(variable) == enable) {
+        return;
     }
+    this->setStatus(variable, SOLAR_TRACER_VARIABLE_OVERWRITTEN, enable);
+    this->logVariableChange(variable);
+    this->updateDerivedEnable(variable);
 }
 
 const void *SolarTracer::getValue(Variable variable) {
-    return this->variableDefine[variable]->value;
+    return this->hasValue(variable) ? this->valueArena + SolarTracer::variableOffset[variable] : nullptr;
 }
 
 bool SolarTracer::setVariableValue(Variable variable, const void *value, bool ignoreOverWriteLock) {
@@ -88,13 +98,174 @@ bool SolarTracer::setVariableValue(Variable variable, const void *value, bool ig
         return true;
     }
     bool valueOk = value != nullptr;
-    if (valueOk) {
+    float filteredValue;
+    if (valueOk && this->filterIndex[variable] != SOLAR_TRACER_NO_FILTER) {
+        filteredValue = this->applyFilter(variable, *(const float *)value);
+        value = &filteredValue;
+    }
+    bool wasReady = this->isVariableReadReady(variable);
+    bool changed = valueOk != wasReady;
+    uint8_t oldValue[VariableDatatypeInfo<VariableDatatype::DT_STRING>::size];
+    if (valueOk && this->hasValue(variable)) {
+        uint8_t *storedValue = this->valueArena + SolarTracer::variableOffset[variable];
         uint8_t vSize = VariableDefiner::getInstance().getVariableSize(variable);
-        if (vSize > 0) {
-            memcpy(this->variableDefine[variable]->value, value, vSize);
+        if (memcmp(storedValue, value, vSize) != 0) {
+            if (wasReady && this->hasSubscriptions(variable)) {
+                memcpy(oldValue, storedValue, vSize);
+            }
+            memcpy(storedValue, value, vSize);
+            changed = true;
         }
+    } else if (wasReady && this->hasSubscriptions(variable)) {
+        // going not ready, the value is not touched
+        memcpy(oldValue, this->valueArena + SolarTracer::variableOffset[variable], VariableDefiner::getInstance().getVariableSize(variable));
+    }
+    // logged with the value change below
+    this->updateReadReady(variable, valueOk);
+    if (changed) {
+        this->setVariableChanged(variable, wasReady ? oldValue : nullptr);
     }
-    this->setVariableReadReady(variable, valueOk);
 
     return valueOk;
 }
+
+void SolarTracer::setVariableChanged(Variable variable, const void *oldValue) {
+    if (!this->hasValue(variable)) {
+        return;
+    }
+    this->logVariableChange(variable);
+
+    const void *newValue = this->isVariableReadReady(variable) ? this->getValue(variable) : nullptr;
+    for (uint8_t index = this->firstSubscription[variable]; index != SOLAR_TRACER_NO_SUBSCRIPTION; index = this->subscriptions[index].next) {
+        this->subscriptions[index].callback(variable, oldValue, newValue);
+    }
+
+    uint8_t dependants = VariableDefiner::getInstance().getDerivedDependants(variable);
+    for (uint8_t index = 0; dependants > 0; index++, dependants >>= 1) {
+        if (dependants & 1) {
+            this->updateDerivedVariable(VariableDefiner::getInstance().getDerivedDefinition(index));
+        }
+    }
+}
+
+void SolarTracer::logVariableChange(Variable variable) {
+    if (!this->hasValue(variable)) {
+        return;
+    }
+    uint8_t logIndex = SolarTracer::getChangeLogIndex(VariableDefiner::getInstance().getDefinition(variable)->source);
+    uint16_t generation = ++this->changeGeneration[logIndex];
+    this->changeLog[logIndex][generation & (SOLAR_TRACER_CHANGE_LOG_SIZE - 1)] = variable;
+    this->variableGeneration[variable] = generation;
+}
+
+void SolarTracer::updateDerivedVariable(const DerivedVariableDefinition *derived) {
+    if (!this->isVariableEnabled(derived->variable)) {
+        return;
+    }
+    if (!this->isVariableReadReady(derived->operand1) || !this->isVariableReadReady(derived->operand2)) {
+        this->setVariableValue(derived->variable, nullptr);
+        return;
+    }
+    float operand1 = *(const float *)this->getValue(derived->operand1);
+    float operand2 = *(const float *)this->getValue(derived->operand2);
+    float result = 0;
+    switch (derived->operation) {
+        case DerivedOperation::DO_DIFFERENCE:
+            result = operand1 - operand2;
+            break;
+        case DerivedOperation::DO_RATIO_PERCENT:
+            result = operand2 > 0 ? operand1 * 100 / operand2 : 0;
+            break;
+    }
+    this->setVariableValue(derived->variable, &result);
+}
+
+void SolarTracer::updateDerivedEnable(Variable operand) {
+    uint8_t dependants = VariableDefiner::getInstance().getDerivedDependants(operand);
+    for (uint8_t index = 0; dependants > 0; index++, dependants >>= 1) {
+        if (dependants & 1) {
+            const DerivedVariableDefinition *derived = VariableDefiner::getInstance().getDerivedDefinition(index);
+            this->setVariableEnable(derived->variable,
+                                    (this->isVariableEnabled(derived->operand1) || this->isVariableOverWritten(derived->operand1)) &&
+                                        (this->isVariableEnabled(derived->operand2) || this->isVariableOverWritten(derived->operand2)));
+        }
+    }
+}
+
+float SolarTracer::applyFilter(Variable variable, float value) {
+    const VariableFilterDefinition *filter = VariableDefiner::getInstance().getFilterDefinition(this->filterIndex[variable]);
+    SolarTracerFilterState *state = &(this->filterStates[this->filterIndex[variable]]);
+    state->raw = value;
+
+    switch (filter->type) {
+        case VariableFilterType::FT_EMA:
+            state->value = state->count == 0 ? value : state->value + (value - state->value) * filter->parameter / 100;
+            state->count = 1;
+            break;
+        case VariableFilterType::FT_MEDIAN: {
+            state->window[state->next] = value;
+            state->next = (state->next + 1) % filter->parameter;
+            if (state->count < filter->parameter) {
+                state->count++;
+            }
+            // insertion sort of a copy, at most VARIABLE_FILTER_MAX_WINDOW samples
+            float sorted[VARIABLE_FILTER_MAX_WINDOW];
+            for (uint8_t index = 0; index < state->count; index++) {
+                uint8_t position = index;
+                for (; position > 0 && sorted[position - 1] > state->window[index]; position--) {
+                    sorted[position] = sorted[position - 1];
+                }
+                sorted[position] = state->window[index];
+            }
+            state->value = sorted[state->count / 2];
+            break;
+        }
+    }
+    return state->value;
+}
+
+float SolarTracer::getRawValue(Variable variable) {
+    if (variable < Variable::VARIABLES_COUNT && this->filterIndex[variable] != SOLAR_TRACER_NO_FILTER) {
+        return this->filterStates[this->filterIndex[variable]].raw;
+    }
+    return this->isVariableReadReady(variable) && VariableDefiner::getInstance().getDatatype(variable) == VariableDatatype::DT_FLOAT ? *(const float *)this->getValue(variable) : 0;
+}
+
+bool SolarTracer::subscribe(Variable variable, OnVariableChangedCallback callback) {
+    if (variable >= Variable::VARIABLES_COUNT || this->subscriptionCount >= SOLAR_TRACER_MAX_SUBSCRIPTIONS) {
+        return false;
+    }
+    this->subscriptions[this->subscriptionCount] = {callback, this->firstSubscription[variable]};
+    this->firstSubscription[variable] = this->subscriptionCount++;
+    return true;
+}
+
+bool SolarTracer::subscribe(uint8_t count, OnVariableChangedCallback callback, ...) {
+    bool result = true;
+    va_list args;
+    va_start(args, callback);
+
+    for (uint8_t i = 1; i <= count; i++) {
+        result = this->subscribe((Variable)va_arg(args, int), callback) && result;
+    }
+
+    va_end(args);
+    return result;
+}
+
+bool SolarTracer::isChangeLogAvailable(VariableSource source, uint16_t generation) {
+    return (uint16_t)(this->getChangeGeneration(source) - generation) <= SOLAR_TRACER_CHANGE_LOG_SIZE;
+}
+
+bool SolarTracer::nextChangedVariable(VariableSource source, uint16_t &cursor, Variable &variable) {
+    uint8_t logIndex = SolarTracer::getChangeLogIndex(source);
+    while (cursor != this->changeGeneration[logIndex]) {
+        cursor++;
+        variable = (Variable)this->changeLog[logIndex][cursor & (SOLAR_TRACER_CHANGE_LOG_SIZE - 1)];
+        // a variable changed more than once is reported at its last change only
+        if (this->variableGeneration[variable] == cursor) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -22,20 +22,87 @@
 #ifndef SOLARTRACER_H
 #define SOLARTRACER_H
 
+#include <type_traits>
+
 #include "../core/VariableDefiner.h"
 
-typedef void (*OnUpdateRunCompletedCallback)();
+/**
+ * Called when a subscribed variable changes, old/new value are null when the variable is not ready
+ */
+typedef void (*OnVariableChangedCallback)(Variable variable, const void *oldValue, const void *newValue);
 
-struct SolarTracerVariableDefinition {
-        /**
-         *  byte 0 - enabled
-         *  byte 1 - ready
-         *  byte 2 - overwritten
-         */
-        uint8_t status;
-        void *value;
+/**
+ * Variable status flags, one bitset each
+ */
+#define SOLAR_TRACER_VARIABLE_ENABLED 0
+#define SOLAR_TRACER_VARIABLE_READY 1
+#define SOLAR_TRACER_VARIABLE_OVERWRITTEN 2
+#define SOLAR_TRACER_VARIABLE_FLAGS 3
+#define SOLAR_TRACER_BITSET_SIZE ((Variable::VARIABLES_COUNT + 7) / 8)
+
+// offset of variables without a value stored in the tracer (internal ones)
+#define SOLAR_TRACER_NO_VALUE_OFFSET 0xFFFF
+
+/**
+ * Layout of the value arena, generated at compile time from VARIABLE_DEFINITION_LIST
+ */
+static constexpr uint8_t solarTracerValueSizes[Variable::VARIABLES_COUNT] = {
+#define _SOLAR_TRACER_VALUE_SIZE(variable, text, datatype, uom, source, mode, blynkVPin, mqttTopic) \
+    VariableSource::source != VariableSource::SR_INTERNAL ? VariableInfo<Variable::variable>::size : (uint8_t)0,
+    VARIABLE_DEFINITION_LIST(_SOLAR_TRACER_VALUE_SIZE)
+#undef _SOLAR_TRACER_VALUE_SIZE
 };
 
+// floats must be word aligned to be accessed directly
+static constexpr uint16_t alignSolarTracerValue(uint16_t offset, uint8_t size) {
+    return size >= 4 ? (offset + 3) & ~3 : (size == 2 ? (offset + 1) & ~1 : offset);
+}
+
+// end of the values of the variables before index
+static constexpr uint16_t getSolarTracerArenaEnd(uint8_t index) {
+    return index == 0 ? 0 : (solarTracerValueSizes[index - 1] == 0 ? getSolarTracerArenaEnd(index - 1) : alignSolarTracerValue(getSolarTracerArenaEnd(index - 1), solarTracerValueSizes[index - 1]) + solarTracerValueSizes[index - 1]);
+}
+
+static constexpr uint16_t getSolarTracerValueOffset(uint8_t index) {
+    return solarTracerValueSizes[index] == 0 ? SOLAR_TRACER_NO_VALUE_OFFSET : alignSolarTracerValue(getSolarTracerArenaEnd(index), solarTracerValueSizes[index]);
+}
+
+#define SOLAR_TRACER_ARENA_SIZE getSolarTracerArenaEnd(Variable::VARIABLES_COUNT)
+
+// max number of variable subscriptions, the rules take one for each variable they check
+#ifndef SOLAR_TRACER_MAX_SUBSCRIPTIONS
+#ifdef USE_VARIABLE_RULES
+#define SOLAR_TRACER_MAX_SUBSCRIPTIONS 32
+#else
+#define SOLAR_TRACER_MAX_SUBSCRIPTIONS 16
+#endif
+#endif
+#define SOLAR_TRACER_NO_SUBSCRIPTION 0xFF
+
+struct SolarTracerSubscription {
+        OnVariableChangedCallback callback;
+        // next subscription to the same variable
+        uint8_t next;
+};
+
+#define SOLAR_TRACER_NO_FILTER 0xFF
+
+/**
+ * Filter of a variable, see VARIABLE_FILTER_LIST
+ */
+struct SolarTracerFilterState {
+        // last value before the filter
+        float raw;
+        float value;
+        // last samples (median)
+        float window[VARIABLE_FILTER_MAX_WINDOW];
+        uint8_t next;
+        uint8_t count;
+};
+
+// changes kept for each source (power of 2), readers falling behind must do a full scan
+#define SOLAR_TRACER_CHANGE_LOG_SIZE 64
+
 class SolarTracer {
     public:
         SolarTracer();
@@ -70,10 +137,70 @@ class SolarTracer {
          */
         bool setVariableValue(Variable variable, const void *value, bool ignoreOverWriteLock = false);
 
-        void setOnUpdateRunCompleted(OnUpdateRunCompletedCallback fn) {
-            this->onUpdateRunCompleted = fn;
+        /**
+         * Get the value of the variable, type resolved at compile time (check isVariableReadReady before)
+         */
+        template <Variable V>
+        inline typename VariableInfo<V>::type get() {
+            return VariableInfo<V>::read(this->valueArena + SolarTracer::variableOffset[V]);
+        }
+
+        /**
+         * Set the value of the variable, the value type must match the variable datatype
+         */
+        template <Variable V, typename T>
+        inline bool set(T value, bool ignoreOverWriteLock = false) {
+            static_assert(std::is_same<T, typename VariableInfo<V>::type>::value, "Value type does not match the variable datatype");
+            if (!this->hasValue(V) || (!ignoreOverWriteLock && this->isVariableOverWritten(V))) {
+                return true;
+            }
+            value = this->filterValue(V, value);
+            uint8_t *storedValue = this->valueArena + SolarTracer::variableOffset[V];
+            bool wasReady = this->isVariableReadReady(V);
+            uint8_t oldValue[VariableInfo<V>::size];
+            if (wasReady && this->hasSubscriptions(V)) {
+                memcpy(oldValue, storedValue, sizeof(oldValue));
+            }
+            bool changed = VariableInfo<V>::write(storedValue, value) || !wasReady;
+            // logged with the value change below
+            this->updateReadReady(V, true);
+            if (changed) {
+                this->setVariableChanged(V, wasReady ? oldValue : nullptr);
+            }
+            return true;
         }
 
+        /**
+         * Get the value of a filtered variable before the filter (the value itself for not filtered ones)
+         */
+        float getRawValue(Variable variable);
+
+        /**
+         * Register a callback for the changes of a variable, false if there is no room left
+         */
+        bool subscribe(Variable variable, OnVariableChangedCallback callback);
+
+        /**
+         * Register a callback for the changes of a group of variables (e.g. a register block), false if there is no room left
+         */
+        bool subscribe(uint8_t count, OnVariableChangedCallback callback, ...);
+
+        /**
+         * Return the generation of the last change (value or read ready status) of a variable from the given source
+         */
+        inline uint16_t getChangeGeneration(VariableSource source);
+
+        /**
+         * Check if all the changes after the given generation are still available in the change log
+         */
+        bool isChangeLogAvailable(VariableSource source, uint16_t generation);
+
+        /**
+         * Get the next variable changed after the generation in cursor, the cursor is moved forward.
+         * Return false when there are no more changes.
+         */
+        bool nextChangedVariable(VariableSource source, uint16_t &cursor, Variable &variable);
+
         /**
          * Return last status code, 0 means the controller is responding to requests correctly.
          */
@@ -87,14 +214,6 @@ class SolarTracer {
         virtual bool testConnection() = 0;
 
     protected:
-        inline bool setFloatVariable(Variable variable, float value);
-
-        void updateRunCompleted() {
-            if (this->onUpdateRunCompleted) {
-                this->onUpdateRunCompleted();
-            }
-        }
-
         void setVariableEnable(Variable variable, bool enable = true);
 
         void setVariableReadReady(Variable variable, bool enable);
@@ -104,16 +223,126 @@ class SolarTracer {
         uint16_t lastControllerCommunicationStatus;
 
     private:
-        OnUpdateRunCompletedCallback onUpdateRunCompleted = nullptr;
-        SolarTracerVariableDefinition **variableDefine;
+        /**
+         * Status of the variables, a bitset for each flag (SOLAR_TRACER_VARIABLE_*)
+         */
+        uint8_t variableStatus[SOLAR_TRACER_VARIABLE_FLAGS][SOLAR_TRACER_BITSET_SIZE] = {};
+        /**
+         * Offset of each variable value in the arena (aligned to the value size)
+         */
+        static constexpr uint16_t variableOffset[Variable::VARIABLES_COUNT] = {
+#define _SOLAR_TRACER_VALUE_OFFSET(variable, text, datatype, uom, source, mode, blynkVPin, mqttTopic) getSolarTracerValueOffset(Variable::variable),
+            VARIABLE_DEFINITION_LIST(_SOLAR_TRACER_VALUE_OFFSET)
+#undef _SOLAR_TRACER_VALUE_OFFSET
+        };
+        /**
+         * Values of all the variables, packed in a single block
+         */
+        alignas(4) uint8_t valueArena[SOLAR_TRACER_ARENA_SIZE] = {};
+
+        /**
+         * Last generation of realtime and stats variables
+         */
+        uint16_t changeGeneration[2] = {};
+        /**
+         * Generation of the last change of each variable
+         */
+        uint16_t variableGeneration[Variable::VARIABLES_COUNT] = {};
+        /**
+         * Variables changed, indexed by generation
+         */
+        uint8_t changeLog[2][SOLAR_TRACER_CHANGE_LOG_SIZE];
+
+        static inline uint8_t getChangeLogIndex(VariableSource source) {
+            return source == VariableSource::SR_STATS ? 1 : 0;
+        }
+
+        SolarTracerSubscription subscriptions[SOLAR_TRACER_MAX_SUBSCRIPTIONS];
+        uint8_t subscriptionCount = 0;
+        /**
+         * First subscription of each variable, SOLAR_TRACER_NO_SUBSCRIPTION if none
+         */
+        uint8_t firstSubscription[Variable::VARIABLES_COUNT];
+
+        SolarTracerFilterState filterStates[FILTERED_VARIABLES_COUNT > 0 ? FILTERED_VARIABLES_COUNT : 1];
+        /**
+         * Filter of each variable, SOLAR_TRACER_NO_FILTER if none
+         */
+        uint8_t filterIndex[Variable::VARIABLES_COUNT];
+
+        /**
+         * Apply the filter of the variable (constant time)
+         */
+        float applyFilter(Variable variable, float value);
+
+        inline void resetFilter(uint8_t index) {
+            this->filterStates[index].count = 0;
+            this->filterStates[index].next = 0;
+        }
+
+        inline float filterValue(Variable variable, float value) {
+            return this->filterIndex[variable] != SOLAR_TRACER_NO_FILTER ? this->applyFilter(variable, value) : value;
+        }
+
+        template <typename T>
+        inline T filterValue(Variable variable, T value) {
+            return value;
+        }
+
+        inline bool hasSubscriptions(Variable variable) {
+            return this->firstSubscription[variable] != SOLAR_TRACER_NO_SUBSCRIPTION;
+        }
+
+        /**
+         * Record the change in the change log and notify the subscribers
+         */
+        void setVariableChanged(Variable variable, const void *oldValue);
+
+        /**
+         * Record the change in the change log only (value, enabled, overwritten or ready state changed)
+         */
+        void logVariableChange(Variable variable);
+
+        /**
+         * Set the ready state, the filter restarts when not ready
+         */
+        void updateReadReady(Variable variable, bool enable);
+
+        /**
+         * Recompute a derived variable from its operands
+         */
+        void updateDerivedVariable(const DerivedVariableDefinition *derived);
+
+        /**
+         * Enable the derived variables of the operand when all their operands are available
+         */
+        void updateDerivedEnable(Variable operand);
+
+        inline bool hasValue(Variable variable) {
+            return variable < Variable::VARIABLES_COUNT && SolarTracer::variableOffset[variable] != SOLAR_TRACER_NO_VALUE_OFFSET;
+        }
+
+        inline bool isStatusSet(Variable variable, uint8_t flag) {
+            return this->hasValue(variable) && (this->variableStatus[flag][variable >> 3] & (1 << (variable & 7))) != 0;
+        }
+
+        inline void setStatus(Variable variable, uint8_t flag, bool enable) {
+            if (this->hasValue(variable)) {
+                if (enable) {
+                    this->variableStatus[flag][variable >> 3] |= (1 << (variable & 7));
+                } else {
+                    this->variableStatus[flag][variable >> 3] &= ~(1 << (variable & 7));
+                }
+            }
+        }
 };
 
 inline const uint16_t SolarTracer::getLastControllerCommunicationStatus() {
     return this->lastControllerCommunicationStatus;
 }
 
-inline bool SolarTracer::setFloatVariable(Variable variable, float value) {
-    return this->setVariableValue(variable, &value);
+inline uint16_t SolarTracer::getChangeGeneration(VariableSource source) {
+    return this->changeGeneration[SolarTracer::getChangeLogIndex(source)];
 }
 
 #endif
@@ -32,7 +32,8 @@ class DummySolarTracer : public SolarTracer {
 
             bool enabled;
             for (uint8_t index = 0; index < Variable::VARIABLES_COUNT; index++) {
-                if (VariableDefiner::getInstance().isFromScc((Variable)index)) {
+                // derived variables are computed by the tracer
+                if (VariableDefiner::getInstance().isFromScc((Variable)index) && !VariableDefiner::getInstance().isDerived((Variable)index)) {
                     this->setVariableEnable((Variable)index, true);
                     this->setVariableReadReady((Variable)index, true);
                 }
@@ -47,6 +48,11 @@ class DummySolarTracer : public SolarTracer {
         }
         virtual void fetchAllValues(){};
         virtual bool updateRun() {
+            for (uint8_t index = 0; index < Variable::VARIABLES_COUNT; index++) {
+                if (this->isVariableEnabled((Variable)index) && !VariableDefiner::getInstance().isDerived((Variable)index)) {
+                    this->setVariableValue((Variable)index, this->getDummyValue((Variable)index));
+                }
+            }
             return true;
         };
         virtual bool writeValue(Variable variable, const void *value) {
@@ -56,7 +62,13 @@ class DummySolarTracer : public SolarTracer {
             return true;
         };
 
-        virtual const void *getValue(Variable variable) {
+    private:
+        bool dummyBoolValue;
+        float dummyFloatValue;
+        char *dummyTextValue;
+        uint16_t dummyUInt16;
+
+        const void *getDummyValue(Variable variable) {
             switch (VariableDefiner::getInstance().getDatatype(variable)) {
                 case VariableDatatype::DT_BOOL:
                     this->dummyBoolValue = random(2) > 0;
@@ -73,11 +85,5 @@ class DummySolarTracer : public SolarTracer {
             }
             return nullptr;
         }
-
-    private:
-        bool dummyBoolValue;
-        float dummyFloatValue;
-        char *dummyTextValue;
-        uint16_t dummyUInt16;
 };
-#endif
\ No newline at end of file
+#endif
@@ -55,25 +55,21 @@ EPEVERSolarTracer::EPEVERSolarTracer(Stream &serialCom, uint16_t serialTimeoutMs
         this->node.setResponseTimeout(serialTimeoutMs);
     };
 
-    // set enabled variables
+    this->setupVariables();
+}
+
+void EPEVERSolarTracer::setupVariables() {
     this->setVariableEnable(Variable::PV_POWER);
     this->setVariableEnable(Variable::PV_CURRENT);
     this->setVariableEnable(Variable::PV_VOLTAGE);
     this->setVariableEnable(Variable::LOAD_CURRENT);
     this->setVariableEnable(Variable::LOAD_POWER);
-    this->setVariableEnable(Variable::BATTERY_TEMP);
     this->setVariableEnable(Variable::BATTERY_VOLTAGE);
-    this->setVariableEnable(Variable::BATTERY_SOC);
-    this->setVariableEnable(Variable::CONTROLLER_TEMP);
     this->setVariableEnable(Variable::BATTERY_CHARGE_CURRENT);
     this->setVariableEnable(Variable::BATTERY_CHARGE_POWER);
-    this->setVariableEnable(Variable::BATTERY_OVERALL_CURRENT);
-    this->setVariableEnable(Variable::LOAD_MANUAL_ONOFF);
-    this->setVariableEnable(Variable::CHARGING_DEVICE_ONOFF);
     this->setVariableEnable(Variable::BATTERY_STATUS_TEXT);
     this->setVariableEnable(Variable::CHARGING_EQUIPMENT_STATUS_TEXT);
     this->setVariableEnable(Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT);
-    this->setVariableEnable(Variable::REMOTE_BATTERY_TEMP);
     this->setVariableEnable(Variable::GENERATED_ENERGY_TODAY);
     this->setVariableEnable(Variable::GENERATED_ENERGY_MONTH);
     this->setVariableEnable(Variable::GENERATED_ENERGY_YEAR);
@@ -86,34 +82,104 @@ EPEVERSolarTracer::EPEVERSolarTracer(Stream &serialCom, uint16_t serialTimeoutMs
     this->setVariableEnable(Variable::MINIMUM_PV_VOLTAGE_TODAY);
     this->setVariableEnable(Variable::MAXIMUM_BATTERY_VOLTAGE_TODAY);
     this->setVariableEnable(Variable::MINIMUM_BATTERY_VOLTAGE_TODAY);
-    this->setVariableEnable(Variable::HEATSINK_TEMP);
-    this->setVariableEnable(Variable::BATTERY_BOOST_VOLTAGE);
-    this->setVariableEnable(Variable::BATTERY_EQUALIZATION_VOLTAGE);
-    this->setVariableEnable(Variable::BATTERY_FLOAT_VOLTAGE);
-    this->setVariableEnable(Variable::BATTERY_FLOAT_MIN_VOLTAGE);
-    this->setVariableEnable(Variable::BATTERY_CHARGING_LIMIT_VOLTAGE);
-    this->setVariableEnable(Variable::BATTERY_DISCHARGING_LIMIT_VOLTAGE);
-    this->setVariableEnable(Variable::BATTERY_LOW_VOLTAGE_DISCONNECT);
-    this->setVariableEnable(Variable::BATTERY_LOW_VOLTAGE_RECONNECT);
-    this->setVariableEnable(Variable::BATTERY_OVER_VOLTAGE_DISCONNECT);
-    this->setVariableEnable(Variable::BATTERY_OVER_VOLTAGE_RECONNECT);
-    this->setVariableEnable(Variable::BATTERY_UNDER_VOLTAGE_SET);
-    this->setVariableEnable(Variable::BATTERY_UNDER_VOLTAGE_RESET);
-    this->setVariableEnable(Variable::BATTERY_OVER_VOLTAGE_RECONNECT);
-    this->setVariableEnable(Variable::BATTERY_UNDER_VOLTAGE_SET);
-    this->setVariableEnable(Variable::BATTERY_UNDER_VOLTAGE_RESET);
-    this->setVariableEnable(Variable::BATTERY_TYPE);
-    this->setVariableEnable(Variable::BATTERY_CAPACITY);
-    this->setVariableEnable(Variable::BATTERY_TEMPERATURE_COMPENSATION_COEFFICIENT);
-
-    this->setVariableEnable(Variable::BATTERY_MANAGEMENT_MODE);
-    this->setVariableEnable(Variable::BATTERY_RATED_VOLTAGE);
-    this->setVariableEnable(Variable::BATTERY_BOOST_DURATION);
-    this->setVariableEnable(Variable::BATTERY_EQUALIZATION_DURATION);
+    this->setVariableEnable(Variable::PV_RATED_POWER);
+
+    // model dependant
+    this->setVariableEnable(Variable::BATTERY_TEMP, EPEVERTraits::hasTemperatureBlock);
+    this->setVariableEnable(Variable::CONTROLLER_TEMP, EPEVERTraits::hasTemperatureBlock);
+    this->setVariableEnable(Variable::HEATSINK_TEMP, EPEVERTraits::hasTemperatureBlock);
+    this->setVariableEnable(Variable::BATTERY_SOC, EPEVERTraits::hasBatterySocBlock);
+    this->setVariableEnable(Variable::REMOTE_BATTERY_TEMP, EPEVERTraits::hasBatterySocBlock);
+    this->setVariableEnable(Variable::BATTERY_OVERALL_CURRENT, EPEVERTraits::hasBatteryOverallCurrent);
+    this->setVariableEnable(Variable::LOAD_MANUAL_ONOFF, EPEVERTraits::hasLoadOutput);
+    this->setVariableEnable(Variable::CHARGING_DEVICE_ONOFF, EPEVERTraits::hasChargingSwitch);
+    this->setVariableEnable(Variable::BATTERY_BOOST_VOLTAGE, EPEVERTraits::hasBatterySettingsBlock);
+    this->setVariableEnable(Variable::BATTERY_EQUALIZATION_VOLTAGE, EPEVERTraits::hasBatterySettingsBlock);
+    this->setVariableEnable(Variable::BATTERY_FLOAT_VOLTAGE, EPEVERTraits::hasBatterySettingsBlock);
+    this->setVariableEnable(Variable::BATTERY_FLOAT_MIN_VOLTAGE, EPEVERTraits::hasBatterySettingsBlock);
+    this->setVariableEnable(Variable::BATTERY_CHARGING_LIMIT_VOLTAGE, EPEVERTraits::hasBatterySettingsBlock);
+    this->setVariableEnable(Variable::BATTERY_DISCHARGING_LIMIT_VOLTAGE, EPEVERTraits::hasBatterySettingsBlock);
+    this->setVariableEnable(Variable::BATTERY_LOW_VOLTAGE_DISCONNECT, EPEVERTraits::hasBatterySettingsBlock);
+    this->setVariableEnable(Variable::BATTERY_LOW_VOLTAGE_RECONNECT, EPEVERTraits::hasBatterySettingsBlock);
+    this->setVariableEnable(Variable::BATTERY_OVER_VOLTAGE_DISCONNECT, EPEVERTraits::hasBatterySettingsBlock);
+    this->setVariableEnable(Variable::BATTERY_OVER_VOLTAGE_RECONNECT, EPEVERTraits::hasBatterySettingsBlock);
+    this->setVariableEnable(Variable::BATTERY_UNDER_VOLTAGE_SET, EPEVERTraits::hasBatterySettingsBlock);
+    this->setVariableEnable(Variable::BATTERY_UNDER_VOLTAGE_RESET, EPEVERTraits::hasBatterySettingsBlock);
+    this->setVariableEnable(Variable::BATTERY_TYPE, EPEVERTraits::hasBatterySettingsBlock);
+    this->setVariableEnable(Variable::BATTERY_CAPACITY, EPEVERTraits::hasBatterySettingsBlock);
+    this->setVariableEnable(Variable::BATTERY_TEMPERATURE_COMPENSATION_COEFFICIENT, EPEVERTraits::hasBatterySettingsBlock);
+    this->setVariableEnable(Variable::BATTERY_RATED_VOLTAGE, EPEVERTraits::hasBatteryRatedLevel);
+    this->setVariableEnable(Variable::BATTERY_MANAGEMENT_MODE, EPEVERTraits::hasChargingDurationBlock);
+    this->setVariableEnable(Variable::BATTERY_BOOST_DURATION, EPEVERTraits::hasChargingDurationBlock);
+    this->setVariableEnable(Variable::BATTERY_EQUALIZATION_DURATION, EPEVERTraits::hasChargingDurationBlock);
+}
+
+bool EPEVERSolarTracer::detectModel() {
+    EPEVERProbeResult result = {};
+
+    // rated data, available on every model: if it does not answer the controller is not there
+    this->onPreNodeRequest();
+    this->lastControllerCommunicationStatus = this->node.readInputRegisters(MODBUS_ADDRESS_RATED_PV_VOLTAGE, 15);
+
+    rs485readSuccess = this->lastControllerCommunicationStatus == this->node.ku8MBSuccess;
+    if (!rs485readSuccess) {
+        return false;
+    }
+    result.ratedVoltage = this->node.getResponseBuffer(MODBUS_ADDRESS_RATED_VOLTAGE - MODBUS_ADDRESS_RATED_PV_VOLTAGE);
+    result.ratedChargingCurrent = this->node.getResponseBuffer(MODBUS_ADDRESS_RATED_CHARGING_CURRENT - MODBUS_ADDRESS_RATED_PV_VOLTAGE);
+    result.ratedLoadCurrent = this->node.getResponseBuffer(MODBUS_ADDRESS_RATED_LOAD_CURRENT - MODBUS_ADDRESS_RATED_PV_VOLTAGE);
+    // every controller has a battery rating: zeros are a bad answer, probed again at the next connection test
+    if (result.ratedVoltage == 0 || result.ratedChargingCurrent == 0) {
+        rs485readSuccess = false;
+        return false;
+    }
+
+    // optional blocks: a single read each, any communication failure aborts the probe
+    if (!(this->probeAddress(MODBUS_FUNCTION_READ_INPUT_REGISTERS, MODBUS_ADDRESS_BATT_TEMP, 3, result.hasTemperatureBlock) &&
+          this->probeAddress(MODBUS_FUNCTION_READ_INPUT_REGISTERS, MODBUS_ADDRESS_BATT_SOC, 2, result.hasBatterySocBlock) &&
+          this->probeAddress(MODBUS_FUNCTION_READ_INPUT_REGISTERS, MODBUS_ADDRESS_BATTERY_OVERALL_CURRENT, 2, result.hasBatteryOverallCurrent) &&
+          this->probeAddress(MODBUS_FUNCTION_READ_COILS, MODBUS_ADDRESS_BATTERY_CHARGE_ONOFF, 1, result.hasChargingSwitch) &&
+          this->probeAddress(MODBUS_FUNCTION_READ_COILS, MODBUS_ADDRESS_LOAD_MANUAL_ONOFF, 1, result.hasLoadOutput) &&
+          this->probeAddress(MODBUS_FUNCTION_READ_HOLDING_REGISTERS, MODBUS_ADDRESS_BATTERY_TYPE, 15, result.hasBatterySettingsBlock) &&
+          this->probeAddress(MODBUS_FUNCTION_READ_HOLDING_REGISTERS, MODBUS_ADDRESS_BATTERY_RATED_LEVEL, 1, result.hasBatteryRatedLevel) &&
+          this->probeAddress(MODBUS_FUNCTION_READ_HOLDING_REGISTERS, MODBUS_ADDRESS_EQUALIZE_DURATION, 6, result.hasChargingDurationBlock))) {
+        return false;
+    }
+    // controllers without load terminals may still answer the load coil
+    result.hasLoadOutput = result.hasLoadOutput && result.ratedLoadCurrent > 0;
+
+    debugPrintf(true, "EPEVER %.0fV %.0fA detected, load %.0fA", result.ratedVoltage / ONE_HUNDRED_FLOAT, result.ratedChargingCurrent / ONE_HUNDRED_FLOAT, result.hasLoadOutput ? result.ratedLoadCurrent / ONE_HUNDRED_FLOAT : 0.0f);
+    EPEVERTraits::applyProbeResult(result);
+    this->modelDetected = true;
+    this->setupVariables();
+
+    return true;
+}
+
+bool EPEVERSolarTracer::probeAddress(uint8_t function, uint16_t address, uint16_t count, bool &available) {
+    this->onPreNodeRequest();
+    switch (function) {
+        case MODBUS_FUNCTION_READ_COILS:
+            this->lastControllerCommunicationStatus = this->node.readCoils(address, count);
+            break;
+        case MODBUS_FUNCTION_READ_HOLDING_REGISTERS:
+            this->lastControllerCommunicationStatus = this->node.readHoldingRegisters(address, count);
+            break;
+        default:
+            this->lastControllerCommunicationStatus = this->node.readInputRegisters(address, count);
+    }
+
+    available = this->lastControllerCommunicationStatus == this->node.ku8MBSuccess;
+    // an exception response: the controller is there, the address is not
+    rs485readSuccess = available || this->lastControllerCommunicationStatus == this->node.ku8MBIllegalDataAddress || this->lastControllerCommunicationStatus == this->node.ku8MBIllegalFunction;
+    return rs485readSuccess;
 }
 
 bool EPEVERSolarTracer::testConnection() {
-    this->readControllerSingleCoil(MODBUS_ADDRESS_LOAD_MANUAL_ONOFF);
+    if (EPEVERTraits::isDetectedAtBoot && !this->modelDetected) {
+        return this->detectModel();
+    }
+    this->readControllerSingleCoil(EPEVERTraits::hasLoadOutput ? MODBUS_ADDRESS_LOAD_MANUAL_ONOFF : MODBUS_ADDRESS_BATTERY_CHARGE_ONOFF);
     return rs485readSuccess;
 }
 
@@ -133,38 +199,43 @@ bool EPEVERSolarTracer::syncRealtimeClock(struct tm *ti) {
 
 void EPEVERSolarTracer::fetchAllValues() {
     // STATS
-    this->updateStats();
-    this->AddressRegistry_9003();
-    this->AddressRegistry_9067();
-    this->AddressRegistry_906B();
+    this->fetchAllStats();
     // REALTIME
     this->AddressRegistry_3100();
-    this->AddressRegistry_3110();
-    this->AddressRegistry_311A();
-    this->AddressRegistry_331B();
+    if (EPEVERTraits::hasTemperatureBlock) {
+        this->AddressRegistry_3110();
+    }
+    if (EPEVERTraits::hasBatterySocBlock) {
+        this->AddressRegistry_311A();
+    }
+    if (EPEVERTraits::hasBatteryOverallCurrent) {
+        this->AddressRegistry_331B();
+    }
     this->fetchValue(Variable::LOAD_MANUAL_ONOFF);
     this->fetchValue(Variable::CHARGING_DEVICE_ONOFF);
     this->fetchAddressStatusVariables();
-
-    // update run completed
-    this->updateRunCompleted();
 }
 
 bool EPEVERSolarTracer::updateRun() {
     switch (globalUpdateCounter) {
         case 360:
             // update statistics
-            this->updateStats();
-            this->AddressRegistry_9003();
-            this->AddressRegistry_9067();
-            this->AddressRegistry_906B();
+            this->fetchAllStats();
             globalUpdateCounter = 0;
             break;
         default:
+            // skip the steps whose register block does not exist on this model
+            while (!EPEVERSolarTracer::isRealtimeStepAvailable(currentRealtimeUpdateCounter)) {
+                currentRealtimeUpdateCounter--;
+            }
             switch (currentRealtimeUpdateCounter) {
                 case 0:
                     globalUpdateCounter++;
                     currentRealtimeUpdateCounter = 5;
+                    if (EPEVERTraits::isDetectedAtBoot && !this->modelDetected) {
+                        // controller was not reachable at boot
+                        this->detectModel();
+                    }
                     this->AddressRegistry_3100();
                     break;
                 case 1:
@@ -180,9 +251,6 @@ bool EPEVERSolarTracer::updateRun() {
                     this->fetchValue(Variable::LOAD_MANUAL_ONOFF);
                     this->fetchValue(Variable::CHARGING_DEVICE_ONOFF);
                     this->fetchAddressStatusVariables();
-
-                    // update run completed
-                    this->updateRunCompleted();
             }
             currentRealtimeUpdateCounter--;
     }
@@ -197,9 +265,15 @@ bool EPEVERSolarTracer::fetchValue(Variable variable) {
             value = this->readControllerSingleCoil(MODBUS_ADDRESS_LOAD_FORCE_ONOFF);
             return this->setVariableValue(variable, _EST_RS_POINTER(rs485readSuccess, value));
         case Variable::LOAD_MANUAL_ONOFF:
+            if (!EPEVERTraits::hasLoadOutput) {
+                break;
+            }
             value = this->readControllerSingleCoil(MODBUS_ADDRESS_LOAD_MANUAL_ONOFF);
             return this->setVariableValue(variable, _EST_RS_POINTER(rs485readSuccess, value));
         case Variable::CHARGING_DEVICE_ONOFF:
+            if (!EPEVERTraits::hasChargingSwitch) {
+                break;
+            }
             value = this->readControllerSingleCoil(MODBUS_ADDRESS_BATTERY_CHARGE_ONOFF);
             return this->setVariableValue(variable, _EST_RS_POINTER(rs485readSuccess, value));
         default:
@@ -238,59 +312,59 @@ bool EPEVERSolarTracer::writeValue(Variable variable, const void *value) {
             writeResult = this->writeControllerHoldingRegister(MODBUS_ADDRESS_BATTERY_RATED_LEVEL, EPEVERSolarTracer::getBatteryVoltageLevelFromVoltage(*(uint16_t *)value));
             break;
         case Variable::BATTERY_MANAGEMENT_MODE:
-            writeResult = this->writeControllerHoldingRegister(MODBUS_ADDRESS_CHARGING_MODE, (*(uint16_t *)value));
+            writeResult = EPEVERTraits::isChargingDurationWritable && this->writeControllerHoldingRegister(MODBUS_ADDRESS_CHARGING_MODE, (*(uint16_t *)value));
             break;
         case Variable::BATTERY_EQUALIZATION_DURATION:
-            writeResult = this->writeControllerHoldingRegister(MODBUS_ADDRESS_EQUALIZE_DURATION, (*(uint16_t *)value));
+            writeResult = EPEVERTraits::isChargingDurationWritable && this->writeControllerHoldingRegister(MODBUS_ADDRESS_EQUALIZE_DURATION, (*(uint16_t *)value));
             break;
         case Variable::BATTERY_BOOST_DURATION:
-            writeResult = this->writeControllerHoldingRegister(MODBUS_ADDRESS_BOOST_DURATION, (*(uint16_t *)value));
+            writeResult = EPEVERTraits::isChargingDurationWritable && this->writeControllerHoldingRegister(MODBUS_ADDRESS_BOOST_DURATION, (*(uint16_t *)value));
             break;
             //
         case Variable::BATTERY_TYPE:
-            writeResult = this->replaceControllerHoldingRegister(MODBUS_ADDRESS_BATTERY_TYPE, (*(uint16_t *)value), MODBUS_ADDRESS_BATTERY_TYPE, 15);
+            writeResult = this->writeBatterySettingHoldingRegister(MODBUS_ADDRESS_BATTERY_TYPE, (*(uint16_t *)value));
             break;
         case Variable::BATTERY_CAPACITY:
-            writeResult = this->replaceControllerHoldingRegister(MODBUS_ADDRESS_BATTERY_CAPACITY, (*(uint16_t *)value), MODBUS_ADDRESS_BATTERY_TYPE, 15);
+            writeResult = this->writeBatterySettingHoldingRegister(MODBUS_ADDRESS_BATTERY_CAPACITY, (*(uint16_t *)value));
             break;
         case Variable::BATTERY_TEMPERATURE_COMPENSATION_COEFFICIENT:
-            writeResult = this->replaceControllerHoldingRegister(MODBUS_ADDRESS_BATTERY_TEMP_COEFF, (*(float *)value) * ONE_HUNDRED_FLOAT, MODBUS_ADDRESS_BATTERY_TYPE, 15);
+            writeResult = this->writeBatterySettingHoldingRegister(MODBUS_ADDRESS_BATTERY_TEMP_COEFF, (*(float *)value) * ONE_HUNDRED_FLOAT);
             break;
         case Variable::BATTERY_OVER_VOLTAGE_DISCONNECT:
-            writeResult = this->replaceControllerHoldingRegister(MODBUS_ADDRESS_HIGH_VOLTAGE_DISCONNECT, (*(float *)value) * ONE_HUNDRED_FLOAT, MODBUS_ADDRESS_BATTERY_TYPE, 15);
+            writeResult = this->writeBatterySettingHoldingRegister(MODBUS_ADDRESS_HIGH_VOLTAGE_DISCONNECT, (*(float *)value) * ONE_HUNDRED_FLOAT);
             break;
         case Variable::BATTERY_CHARGING_LIMIT_VOLTAGE:
-            writeResult = this->replaceControllerHoldingRegister(MODBUS_ADDRESS_CHARGING_LIMIT_VOLTAGE, (*(float *)value) * ONE_HUNDRED_FLOAT, MODBUS_ADDRESS_BATTERY_TYPE, 15);
+            writeResult = this->writeBatterySettingHoldingRegister(MODBUS_ADDRESS_CHARGING_LIMIT_VOLTAGE, (*(float *)value) * ONE_HUNDRED_FLOAT);
             break;
         case Variable::BATTERY_OVER_VOLTAGE_RECONNECT:
-            writeResult = this->replaceControllerHoldingRegister(MODBUS_ADDRESS_OVER_VOLTAGE_RECONNECT, (*(float *)value) * ONE_HUNDRED_FLOAT, MODBUS_ADDRESS_BATTERY_TYPE, 15);
+            writeResult = this->writeBatterySettingHoldingRegister(MODBUS_ADDRESS_OVER_VOLTAGE_RECONNECT, (*(float *)value) * ONE_HUNDRED_FLOAT);
             break;
         case Variable::BATTERY_EQUALIZATION_VOLTAGE:
-            writeResult = this->replaceControllerHoldingRegister(MODBUS_ADDRESS_EQUALIZATION_VOLTAGE, (*(float *)value) * ONE_HUNDRED_FLOAT, MODBUS_ADDRESS_BATTERY_TYPE, 15);
+            writeResult = this->writeBatterySettingHoldingRegister(MODBUS_ADDRESS_EQUALIZATION_VOLTAGE, (*(float *)value) * ONE_HUNDRED_FLOAT);
             break;
         case Variable::BATTERY_BOOST_VOLTAGE:
-            writeResult = this->replaceControllerHoldingRegister(MODBUS_ADDRESS_BOOST_VOLTAGE, (*(float *)value) * ONE_HUNDRED_FLOAT, MODBUS_ADDRESS_BATTERY_TYPE, 15);
+            writeResult = this->writeBatterySettingHoldingRegister(MODBUS_ADDRESS_BOOST_VOLTAGE, (*(float *)value) * ONE_HUNDRED_FLOAT);
             break;
         case Variable::BATTERY_FLOAT_VOLTAGE:
-            writeResult = this->replaceControllerHoldingRegister(MODBUS_ADDRESS_FLOAT_VOLTAGE, (*(float *)value) * ONE_HUNDRED_FLOAT, MODBUS_ADDRESS_BATTERY_TYPE, 15);
+            writeResult = this->writeBatterySettingHoldingRegister(MODBUS_ADDRESS_FLOAT_VOLTAGE, (*(float *)value) * ONE_HUNDRED_FLOAT);
             break;
         case Variable::BATTERY_FLOAT_MIN_VOLTAGE:
-            writeResult = this->replaceControllerHoldingRegister(MODBUS_ADDRESS_BOOST_RECONNECT_VOLTAGE, (*(float *)value) * ONE_HUNDRED_FLOAT, MODBUS_ADDRESS_BATTERY_TYPE, 15);
+            writeResult = this->writeBatterySettingHoldingRegister(MODBUS_ADDRESS_BOOST_RECONNECT_VOLTAGE, (*(float *)value) * ONE_HUNDRED_FLOAT);
             break;
         case Variable::BATTERY_LOW_VOLTAGE_RECONNECT:
-            writeResult = this->replaceControllerHoldingRegister(MODBUS_ADDRESS_LOW_VOLTAGE_RECONNECT, (*(float *)value) * ONE_HUNDRED_FLOAT, MODBUS_ADDRESS_BATTERY_TYPE, 15);
+            writeResult = this->writeBatterySettingHoldingRegister(MODBUS_ADDRESS_LOW_VOLTAGE_RECONNECT, (*(float *)value) * ONE_HUNDRED_FLOAT);
             break;
         case Variable::BATTERY_UNDER_VOLTAGE_RESET:
-            writeResult = this->replaceControllerHoldingRegister(MODBUS_ADDRESS_UNDER_VOLTAGE_RECOVER, (*(float *)value) * ONE_HUNDRED_FLOAT, MODBUS_ADDRESS_BATTERY_TYPE, 15);
+            writeResult = this->writeBatterySettingHoldingRegister(MODBUS_ADDRESS_UNDER_VOLTAGE_RECOVER, (*(float *)value) * ONE_HUNDRED_FLOAT);
             break;
         case Variable::BATTERY_UNDER_VOLTAGE_SET:
-            writeResult = this->replaceControllerHoldingRegister(MODBUS_ADDRESS_UNDER_VOLTAGE_WARNING, (*(float *)value) * ONE_HUNDRED_FLOAT, MODBUS_ADDRESS_BATTERY_TYPE, 15);
+            writeResult = this->writeBatterySettingHoldingRegister(MODBUS_ADDRESS_UNDER_VOLTAGE_WARNING, (*(float *)value) * ONE_HUNDRED_FLOAT);
             break;
         case Variable::BATTERY_LOW_VOLTAGE_DISCONNECT:
-            writeResult = this->replaceControllerHoldingRegister(MODBUS_ADDRESS_LOW_VOLTAGE_DISCONNECT, (*(float *)value) * ONE_HUNDRED_FLOAT, MODBUS_ADDRESS_BATTERY_TYPE, 15);
+            writeResult = this->writeBatterySettingHoldingRegister(MODBUS_ADDRESS_LOW_VOLTAGE_DISCONNECT, (*(float *)value) * ONE_HUNDRED_FLOAT);
             break;
         case Variable::BATTERY_DISCHARGING_LIMIT_VOLTAGE:
-            writeResult = this->replaceControllerHoldingRegister(MODBUS_ADDRESS_DISCHARGING_LIMIT_VOLTAGE, (*(float *)value) * ONE_HUNDRED_FLOAT, MODBUS_ADDRESS_BATTERY_TYPE, 15);
+            writeResult = this->writeBatterySettingHoldingRegister(MODBUS_ADDRESS_DISCHARGING_LIMIT_VOLTAGE, (*(float *)value) * ONE_HUNDRED_FLOAT);
             break;
     }
 
@@ -347,20 +421,43 @@ bool EPEVERSolarTracer::replaceControllerHoldingRegister(uint16_t address, uint1
     return false;
 }
 
+bool EPEVERSolarTracer::writeBatterySettingHoldingRegister(uint16_t address, uint16_t value) {
+    if (!EPEVERTraits::isBatterySettingsWritable) {
+        return false;
+    }
+    if (EPEVERTraits::batterySettingsWriteBlockSize == 0) {
+        return this->writeControllerHoldingRegister(address, value);
+    }
+    return this->replaceControllerHoldingRegister(address, value, MODBUS_ADDRESS_BATTERY_TYPE, EPEVERTraits::batterySettingsWriteBlockSize);
+}
+
+void EPEVERSolarTracer::AddressRegistry_3002() {
+    this->onPreNodeRequest();
+    this->lastControllerCommunicationStatus = this->node.readInputRegisters(MODBUS_ADDRESS_RATED_PV_POWER, 2);
+
+    rs485readSuccess = this->lastControllerCommunicationStatus == this->node.ku8MBSuccess;
+    if (rs485readSuccess) {
+        this->set<Variable::PV_RATED_POWER>((this->node.getResponseBuffer(0x00) | this->node.getResponseBuffer(0x01) << 16) / ONE_HUNDRED_FLOAT);
+        return;
+    }
+
+    this->setVariableReadReady(Variable::PV_RATED_POWER, rs485readSuccess);
+}
+
 void EPEVERSolarTracer::AddressRegistry_3100() {
     this->onPreNodeRequest();
     this->lastControllerCommunicationStatus = this->node.readInputRegisters(MODBUS_ADDRESS_PV_VOLTAGE, 16);
 
     rs485readSuccess = this->lastControllerCommunicationStatus == this->node.ku8MBSuccess;
     if (rs485readSuccess) {
-        this->setFloatVariable(Variable::PV_VOLTAGE, this->node.getResponseBuffer(0x00) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::PV_CURRENT, this->node.getResponseBuffer(0x01) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::PV_POWER, (this->node.getResponseBuffer(0x02) | this->node.getResponseBuffer(0x03) << 16) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::BATTERY_VOLTAGE, this->node.getResponseBuffer(0x04) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::BATTERY_CHARGE_CURRENT, this->node.getResponseBuffer(0x05) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::BATTERY_CHARGE_POWER, (this->node.getResponseBuffer(0x06) | this->node.getResponseBuffer(0x07) << 16) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::LOAD_CURRENT, this->node.getResponseBuffer(0x0D) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::LOAD_POWER, (this->node.getResponseBuffer(0x0E) | this->node.getResponseBuffer(0x0F) << 16) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::PV_VOLTAGE>(this->node.getResponseBuffer(0x00) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::PV_CURRENT>(this->node.getResponseBuffer(0x01) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::PV_POWER>((this->node.getResponseBuffer(0x02) | this->node.getResponseBuffer(0x03) << 16) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_VOLTAGE>(this->node.getResponseBuffer(0x04) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_CHARGE_CURRENT>(this->node.getResponseBuffer(0x05) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_CHARGE_POWER>((this->node.getResponseBuffer(0x06) | this->node.getResponseBuffer(0x07) << 16) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::LOAD_CURRENT>(this->node.getResponseBuffer(0x0D) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::LOAD_POWER>((this->node.getResponseBuffer(0x0E) | this->node.getResponseBuffer(0x0F) << 16) / ONE_HUNDRED_FLOAT);
         return;
     }
 
@@ -382,9 +479,9 @@ void EPEVERSolarTracer::AddressRegistry_3110() {
 
     rs485readSuccess = this->lastControllerCommunicationStatus == this->node.ku8MBSuccess;
     if (rs485readSuccess) {
-        this->setFloatVariable(Variable::BATTERY_TEMP, this->node.getResponseBuffer(0x00) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::CONTROLLER_TEMP, this->node.getResponseBuffer(0x01) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::HEATSINK_TEMP, this->node.getResponseBuffer(0x02) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_TEMP>(this->node.getResponseBuffer(0x00) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::CONTROLLER_TEMP>(this->node.getResponseBuffer(0x01) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::HEATSINK_TEMP>(this->node.getResponseBuffer(0x02) / ONE_HUNDRED_FLOAT);
 
         return;
     }
@@ -401,8 +498,8 @@ void EPEVERSolarTracer::AddressRegistry_311A() {
 
     rs485readSuccess = this->lastControllerCommunicationStatus == this->node.ku8MBSuccess;
     if (rs485readSuccess) {
-        this->setFloatVariable(Variable::BATTERY_SOC, this->node.getResponseBuffer(0x00) / 1.0f);
-        this->setFloatVariable(Variable::REMOTE_BATTERY_TEMP, this->node.getResponseBuffer(0x01) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_SOC>(this->node.getResponseBuffer(0x00) / 1.0f);
+        this->set<Variable::REMOTE_BATTERY_TEMP>(this->node.getResponseBuffer(0x01) / ONE_HUNDRED_FLOAT);
 
         return;
     }
@@ -418,7 +515,7 @@ void EPEVERSolarTracer::AddressRegistry_331B() {
 
     rs485readSuccess = this->lastControllerCommunicationStatus == this->node.ku8MBSuccess;
     if (rs485readSuccess) {
-        this->setFloatVariable(Variable::BATTERY_OVERALL_CURRENT, (this->node.getResponseBuffer(0x00) | this->node.getResponseBuffer(0x01) << 16) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_OVERALL_CURRENT>((this->node.getResponseBuffer(0x00) | this->node.getResponseBuffer(0x01) << 16) / ONE_HUNDRED_FLOAT);
     }
 
     this->setVariableReadReady(Variable::BATTERY_OVERALL_CURRENT, rs485readSuccess);
@@ -431,22 +528,22 @@ void EPEVERSolarTracer::AddressRegistry_9003() {
     rs485readSuccess = this->lastControllerCommunicationStatus == this->node.ku8MBSuccess;
     if (rs485readSuccess) {
         uint16_t sharedUInt16 = this->node.getResponseBuffer(0x00);
-        this->setVariableValue(Variable::BATTERY_TYPE, &sharedUInt16);
+        this->set<Variable::BATTERY_TYPE>(sharedUInt16);
         sharedUInt16 = this->node.getResponseBuffer(0x01);
-        this->setVariableValue(Variable::BATTERY_CAPACITY, &sharedUInt16);
-        this->setFloatVariable(Variable::BATTERY_TEMPERATURE_COMPENSATION_COEFFICIENT, this->node.getResponseBuffer(0x02) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::BATTERY_OVER_VOLTAGE_DISCONNECT, this->node.getResponseBuffer(0x03) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::BATTERY_CHARGING_LIMIT_VOLTAGE, this->node.getResponseBuffer(0x04) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::BATTERY_OVER_VOLTAGE_RECONNECT, this->node.getResponseBuffer(0x05) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::BATTERY_EQUALIZATION_VOLTAGE, this->node.getResponseBuffer(0x06) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::BATTERY_BOOST_VOLTAGE, this->node.getResponseBuffer(0x07) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::BATTERY_FLOAT_VOLTAGE, this->node.getResponseBuffer(0x08) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::BATTERY_FLOAT_MIN_VOLTAGE, this->node.getResponseBuffer(0x09) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::BATTERY_LOW_VOLTAGE_RECONNECT, this->node.getResponseBuffer(0x0A) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::BATTERY_UNDER_VOLTAGE_RESET, this->node.getResponseBuffer(0x0B) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::BATTERY_UNDER_VOLTAGE_SET, this->node.getResponseBuffer(0x0C) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::BATTERY_LOW_VOLTAGE_DISCONNECT, this->node.getResponseBuffer(0x0D) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::BATTERY_DISCHARGING_LIMIT_VOLTAGE, this->node.getResponseBuffer(0x0E) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_CAPACITY>(sharedUInt16);
+        this->set<Variable::BATTERY_TEMPERATURE_COMPENSATION_COEFFICIENT>(this->node.getResponseBuffer(0x02) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_OVER_VOLTAGE_DISCONNECT>(this->node.getResponseBuffer(0x03) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_CHARGING_LIMIT_VOLTAGE>(this->node.getResponseBuffer(0x04) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_OVER_VOLTAGE_RECONNECT>(this->node.getResponseBuffer(0x05) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_EQUALIZATION_VOLTAGE>(this->node.getResponseBuffer(0x06) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_BOOST_VOLTAGE>(this->node.getResponseBuffer(0x07) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_FLOAT_VOLTAGE>(this->node.getResponseBuffer(0x08) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_FLOAT_MIN_VOLTAGE>(this->node.getResponseBuffer(0x09) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_LOW_VOLTAGE_RECONNECT>(this->node.getResponseBuffer(0x0A) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_UNDER_VOLTAGE_RESET>(this->node.getResponseBuffer(0x0B) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_UNDER_VOLTAGE_SET>(this->node.getResponseBuffer(0x0C) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_LOW_VOLTAGE_DISCONNECT>(this->node.getResponseBuffer(0x0D) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::BATTERY_DISCHARGING_LIMIT_VOLTAGE>(this->node.getResponseBuffer(0x0E) / ONE_HUNDRED_FLOAT);
         return;
     }
 
@@ -476,7 +573,7 @@ void EPEVERSolarTracer::AddressRegistry_9067() {
     rs485readSuccess = this->lastControllerCommunicationStatus == this->node.ku8MBSuccess;
     if (rs485readSuccess) {
         uint16_t sharedUInt16 = EPEVERSolarTracer::getVoltageFromBatteryVoltageLevel(this->node.getResponseBuffer(0x00));
-        this->setVariableValue(Variable::BATTERY_RATED_VOLTAGE, &sharedUInt16);
+        this->set<Variable::BATTERY_RATED_VOLTAGE>(sharedUInt16);
 
         return;
     }
@@ -490,11 +587,11 @@ void EPEVERSolarTracer::AddressRegistry_906B() {
     rs485readSuccess = this->lastControllerCommunicationStatus == this->node.ku8MBSuccess;
     if (rs485readSuccess) {
         uint16_t sharedUInt16 = this->node.getResponseBuffer(0x00);
-        this->setVariableValue(Variable::BATTERY_EQUALIZATION_DURATION, &sharedUInt16);
+        this->set<Variable::BATTERY_EQUALIZATION_DURATION>(sharedUInt16);
         sharedUInt16 = this->node.getResponseBuffer(0x01);
-        this->setVariableValue(Variable::BATTERY_BOOST_DURATION, &sharedUInt16);
+        this->set<Variable::BATTERY_BOOST_DURATION>(sharedUInt16);
         sharedUInt16 = this->node.getResponseBuffer(0x05);
-        this->setVariableValue(Variable::BATTERY_MANAGEMENT_MODE, &sharedUInt16);
+        this->set<Variable::BATTERY_MANAGEMENT_MODE>(sharedUInt16);
         return;
     }
 
@@ -515,33 +612,33 @@ void EPEVERSolarTracer::fetchAddressStatusVariables() {
             // fault
             switch (batteryStatus & 3) {
                 case 1:
-                    this->setVariableValue(Variable::BATTERY_STATUS_TEXT, "! OVER VOLT");
+                    this->set<Variable::BATTERY_STATUS_TEXT>("! OVER VOLT");
                     break;
                 case 2:
-                    this->setVariableValue(Variable::BATTERY_STATUS_TEXT, "! UNDER VOLT");
+                    this->set<Variable::BATTERY_STATUS_TEXT>("! UNDER VOLT");
                     break;
                 case 3:
-                    this->setVariableValue(Variable::BATTERY_STATUS_TEXT, "! LOW VOLT");
+                    this->set<Variable::BATTERY_STATUS_TEXT>("! LOW VOLT");
                     break;
                 case 4:
-                    this->setVariableValue(Variable::BATTERY_STATUS_TEXT, "! FAULT");
+                    this->set<Variable::BATTERY_STATUS_TEXT>("! FAULT");
                     break;
             }
 
             switch ((batteryStatus >> 4) & 3) {
                 case 1:
-                    this->setVariableValue(Variable::BATTERY_STATUS_TEXT, "! OVER TEMP");
+                    this->set<Variable::BATTERY_STATUS_TEXT>("! OVER TEMP");
                     break;
                 case 2:
-                    this->setVariableValue(Variable::BATTERY_STATUS_TEXT, "! LOW TEMP");
+                    this->set<Variable::BATTERY_STATUS_TEXT>("! LOW TEMP");
                     break;
             }
 
             if (batteryStatus >> 8) {
-                this->setVariableValue(Variable::BATTERY_STATUS_TEXT, "! ABN BATT. RESIST.");
+                this->set<Variable::BATTERY_STATUS_TEXT>("! ABN BATT. RESIST.");
             }
         } else {
-            this->setVariableValue(Variable::BATTERY_STATUS_TEXT, "Normal");
+            this->set<Variable::BATTERY_STATUS_TEXT>("Normal");
         }
 
         uint16_t chargingStatus = node.getResponseBuffer(0x01);
@@ -554,19 +651,19 @@ void EPEVERSolarTracer::fetchAddressStatusVariables() {
         } else {
             switch ((chargingStatus >> 2) & 3) {
                 case 0:
-                    this->setVariableValue(Variable::CHARGING_EQUIPMENT_STATUS_TEXT, "Standby");
+                    this->set<Variable::CHARGING_EQUIPMENT_STATUS_TEXT>("Standby");
                     break;
                 case 1:
-                    this->setVariableValue(Variable::CHARGING_EQUIPMENT_STATUS_TEXT, "Float");
+                    this->set<Variable::CHARGING_EQUIPMENT_STATUS_TEXT>("Float");
                     break;
                 case 2:
-                    this->setVariableValue(Variable::CHARGING_EQUIPMENT_STATUS_TEXT, "Boost");
+                    this->set<Variable::CHARGING_EQUIPMENT_STATUS_TEXT>("Boost");
                     break;
                 case 3:
-                    this->setVariableValue(Variable::CHARGING_EQUIPMENT_STATUS_TEXT, "Equalization");
+                    this->set<Variable::CHARGING_EQUIPMENT_STATUS_TEXT>("Equalization");
                     break;
                 default:
-                    this->setVariableValue(Variable::CHARGING_EQUIPMENT_STATUS_TEXT, "??");
+                    this->set<Variable::CHARGING_EQUIPMENT_STATUS_TEXT>("??");
             }
         }
 
@@ -574,29 +671,29 @@ void EPEVERSolarTracer::fetchAddressStatusVariables() {
         if (dischargingStatus & 2) {
             // fault
             if (dischargingStatus & 16) {
-                this->setVariableValue(Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT, "! OUT OVER VOLT.");
+                this->set<Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT>("! OUT OVER VOLT.");
             } else if (dischargingStatus & 32) {
-                this->setVariableValue(Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT, "! BOOST OVER VOLT");
+                this->set<Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT>("! BOOST OVER VOLT");
             } else if (dischargingStatus & 64) {
-                this->setVariableValue(Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT, "! HV SIDE SHORT");
+                this->set<Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT>("! HV SIDE SHORT");
             } else if (dischargingStatus & 128) {
-                this->setVariableValue(Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT, "! INPUT OVER VOLT.");
+                this->set<Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT>("! INPUT OVER VOLT.");
             } else if (dischargingStatus & 256) {
-                this->setVariableValue(Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT, "! OUT VOLT. ABN");
+                this->set<Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT>("! OUT VOLT. ABN");
             } else if (dischargingStatus & 512) {
-                this->setVariableValue(Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT, "! UNABLE STOP DISC.");
+                this->set<Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT>("! UNABLE STOP DISC.");
             } else if (dischargingStatus & 1024) {
-                this->setVariableValue(Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT, "! UNABLE DISC.");
+                this->set<Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT>("! UNABLE DISC.");
             } else if (dischargingStatus & 2048) {
-                this->setVariableValue(Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT, "! SHORT");
+                this->set<Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT>("! SHORT");
             } else {
-                this->setVariableValue(Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT, "! ??");
+                this->set<Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT>("! ??");
             }
         } else {
             if (dischargingStatus & 1) {
-                this->setVariableValue(Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT, "Running");
+                this->set<Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT>("Running");
             } else {
-                this->setVariableValue(Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT, "Standby");
+                this->set<Variable::DISCHARGING_EQUIPMENT_STATUS_TEXT>("Standby");
             }
         }
         return;
@@ -614,22 +711,22 @@ void EPEVERSolarTracer::updateStats() {
 
     rs485readSuccess = this->lastControllerCommunicationStatus == this->node.ku8MBSuccess;
     if (rs485readSuccess) {
-        this->setFloatVariable(Variable::MAXIMUM_PV_VOLTAGE_TODAY, this->node.getResponseBuffer(0) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::MINIMUM_PV_VOLTAGE_TODAY, this->node.getResponseBuffer(1) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::MAXIMUM_BATTERY_VOLTAGE_TODAY, this->node.getResponseBuffer(2) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::MINIMUM_BATTERY_VOLTAGE_TODAY, this->node.getResponseBuffer(3) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::MAXIMUM_PV_VOLTAGE_TODAY>(this->node.getResponseBuffer(0) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::MINIMUM_PV_VOLTAGE_TODAY>(this->node.getResponseBuffer(1) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::MAXIMUM_BATTERY_VOLTAGE_TODAY>(this->node.getResponseBuffer(2) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::MINIMUM_BATTERY_VOLTAGE_TODAY>(this->node.getResponseBuffer(3) / ONE_HUNDRED_FLOAT);
 
         if(!this->isVariableOverWritten(Variable::CONSUMED_ENERGY_TOTAL)){
-            this->setFloatVariable(Variable::CONSUMED_ENERGY_TODAY, (this->node.getResponseBuffer(4) | this->node.getResponseBuffer(5) << 16) / ONE_HUNDRED_FLOAT);
-            this->setFloatVariable(Variable::CONSUMED_ENERGY_MONTH, (this->node.getResponseBuffer(6) | this->node.getResponseBuffer(7) << 16) / ONE_HUNDRED_FLOAT);
-            this->setFloatVariable(Variable::CONSUMED_ENERGY_YEAR, (this->node.getResponseBuffer(8) | this->node.getResponseBuffer(9) << 16) / ONE_HUNDRED_FLOAT);
-            this->setFloatVariable(Variable::CONSUMED_ENERGY_TOTAL, (this->node.getResponseBuffer(10) | this->node.getResponseBuffer(11) << 16) / ONE_HUNDRED_FLOAT);
+            this->set<Variable::CONSUMED_ENERGY_TODAY>((this->node.getResponseBuffer(4) | this->node.getResponseBuffer(5) << 16) / ONE_HUNDRED_FLOAT);
+            this->set<Variable::CONSUMED_ENERGY_MONTH>((this->node.getResponseBuffer(6) | this->node.getResponseBuffer(7) << 16) / ONE_HUNDRED_FLOAT);
+            this->set<Variable::CONSUMED_ENERGY_YEAR>((this->node.getResponseBuffer(8) | this->node.getResponseBuffer(9) << 16) / ONE_HUNDRED_FLOAT);
+            this->set<Variable::CONSUMED_ENERGY_TOTAL>((this->node.getResponseBuffer(10) | this->node.getResponseBuffer(11) << 16) / ONE_HUNDRED_FLOAT);
         }
 
-        this->setFloatVariable(Variable::GENERATED_ENERGY_TODAY, (this->node.getResponseBuffer(12) | this->node.getResponseBuffer(13) << 16) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::GENERATED_ENERGY_MONTH, (this->node.getResponseBuffer(14) | this->node.getResponseBuffer(15) << 16) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::GENERATED_ENERGY_YEAR, (this->node.getResponseBuffer(16) | this->node.getResponseBuffer(17) << 16) / ONE_HUNDRED_FLOAT);
-        this->setFloatVariable(Variable::GENERATED_ENERGY_TOTAL, (this->node.getResponseBuffer(18) | this->node.getResponseBuffer(19) << 16) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::GENERATED_ENERGY_TODAY>((this->node.getResponseBuffer(12) | this->node.getResponseBuffer(13) << 16) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::GENERATED_ENERGY_MONTH>((this->node.getResponseBuffer(14) | this->node.getResponseBuffer(15) << 16) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::GENERATED_ENERGY_YEAR>((this->node.getResponseBuffer(16) | this->node.getResponseBuffer(17) << 16) / ONE_HUNDRED_FLOAT);
+        this->set<Variable::GENERATED_ENERGY_TOTAL>((this->node.getResponseBuffer(18) | this->node.getResponseBuffer(19) << 16) / ONE_HUNDRED_FLOAT);
     }
 
     this->setVariableReadReady(8, rs485readSuccess,
@@ -643,6 +740,20 @@ void EPEVERSolarTracer::updateStats() {
                                Variable::GENERATED_ENERGY_TOTAL);
 }
 
+void EPEVERSolarTracer::fetchAllStats() {
+    this->updateStats();
+    this->AddressRegistry_3002();
+    if (EPEVERTraits::hasBatterySettingsBlock) {
+        this->AddressRegistry_9003();
+    }
+    if (EPEVERTraits::hasBatteryRatedLevel) {
+        this->AddressRegistry_9067();
+    }
+    if (EPEVERTraits::hasChargingDurationBlock) {
+        this->AddressRegistry_906B();
+    }
+}
+
 void EPEVERSolarTracer::onModbusPreTransmission() {
     digitalWrite(this->max485_re_neg, 1);
     digitalWrite(this->max485_de, 1);
@@ -656,3 +767,13 @@ void EPEVERSolarTracer::onModbusPostTransmission() {
     digitalWrite(this->max485_re_neg, 0);
     digitalWrite(this->max485_de, 0);
 }
+
+// detected at boot: shared register blocks only, until the probe succeeds
+bool EPEVERTraits::hasTemperatureBlock = !EPEVERTraits::isDetectedAtBoot;
+bool EPEVERTraits::hasBatterySocBlock = !EPEVERTraits::isDetectedAtBoot;
+bool EPEVERTraits::hasBatteryOverallCurrent = !EPEVERTraits::isDetectedAtBoot;
+bool EPEVERTraits::hasLoadOutput = !EPEVERTraits::isDetectedAtBoot;
+bool EPEVERTraits::hasChargingSwitch = !EPEVERTraits::isDetectedAtBoot;
+bool EPEVERTraits::hasBatterySettingsBlock = !EPEVERTraits::isDetectedAtBoot;
+bool EPEVERTraits::hasBatteryRatedLevel = !EPEVERTraits::isDetectedAtBoot;
+bool EPEVERTraits::hasChargingDurationBlock = !EPEVERTraits::isDetectedAtBoot;
@@ -27,7 +27,11 @@
 #include <time.h>
 
 #include "../SolarTracer.h"
+#include "EPEVER_model_traits.h"
 
+/**
+ * EPEVER solar charge controller, register map given by EPEVERTraits (see EPEVER_model_traits.h)
+ */
 class EPEVERSolarTracer : public SolarTracer, public ModbusMasterCallable {
     public:
         EPEVERSolarTracer(Stream &serialCom, uint16_t serialTimeoutMs, uint8_t slave, uint8_t max485_de, uint8_t max485_re_neg, uint16_t preTransmitWait);
@@ -45,6 +49,8 @@ class EPEVERSolarTracer : public SolarTracer, public ModbusMasterCallable {
 
         bool readControllerSingleCoil(uint16_t address);
 
+        void AddressRegistry_3002();
+
         void AddressRegistry_3100();
 
         void AddressRegistry_3110();
@@ -63,6 +69,8 @@ class EPEVERSolarTracer : public SolarTracer, public ModbusMasterCallable {
 
         void updateStats();
 
+        void fetchAllStats();
+
         /*
              Implementation of ModbusMasterCallable
           */
@@ -80,6 +88,8 @@ class EPEVERSolarTracer : public SolarTracer, public ModbusMasterCallable {
 
         bool rs485readSuccess;
 
+        bool modelDetected = false;
+
         uint16_t globalUpdateCounter = 0;
         uint8_t currentRealtimeUpdateCounter = 0;
 
@@ -90,12 +100,34 @@ class EPEVERSolarTracer : public SolarTracer, public ModbusMasterCallable {
         bool writeControllerSingleCoil(uint16_t address, bool value);
         bool writeControllerHoldingRegister(uint16_t address, uint16_t value);
         bool replaceControllerHoldingRegister(uint16_t address, uint16_t value, uint16_t fromAddress, uint8_t count);
+        bool writeBatterySettingHoldingRegister(uint16_t address, uint16_t value);
+        bool probeAddress(uint8_t function, uint16_t address, uint16_t count, bool &available);
+
+        /**
+         * Enable the variables available on the model
+         */
+        void setupVariables();
+
+        /**
+         * Probe the controller (rated data + optional register blocks) and activate the detected register map
+         */
+        bool detectModel();
 
         static constexpr const float ONE_HUNDRED_FLOAT = 100;
 
     private:
         static const uint8_t voltageLevels[];
 
+        /**
+         * Check if the register block polled in the given realtime step exists on this model
+         */
+        static bool isRealtimeStepAvailable(uint8_t step) {
+            return step == 1   ? EPEVERTraits::hasTemperatureBlock
+                   : step == 2 ? EPEVERTraits::hasBatterySocBlock
+                   : step == 3 ? EPEVERTraits::hasBatteryOverallCurrent
+                               : true;
+        }
+
         void onPreNodeRequest() {
             if (this->preTransmitWaitMs > 0) {
                 delay(this->preTransmitWaitMs);
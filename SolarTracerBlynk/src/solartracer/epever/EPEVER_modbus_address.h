@@ -22,6 +22,15 @@
 #ifndef EPEVER_modbus_address_h
 #define EPEVER_modbus_address_h
 
+#define MODBUS_FUNCTION_READ_COILS 0x01
+#define MODBUS_FUNCTION_READ_HOLDING_REGISTERS 0x03
+#define MODBUS_FUNCTION_READ_INPUT_REGISTERS 0x04
+
+#define MODBUS_ADDRESS_RATED_PV_VOLTAGE 0x3000
+#define MODBUS_ADDRESS_RATED_PV_POWER 0x3002
+#define MODBUS_ADDRESS_RATED_VOLTAGE 0x3004
+#define MODBUS_ADDRESS_RATED_CHARGING_CURRENT 0x3005
+#define MODBUS_ADDRESS_RATED_LOAD_CURRENT 0x300E
 #define MODBUS_ADDRESS_PV_VOLTAGE 0x3100
 #define MODBUS_ADDRESS_PV_POWER 0x3102
 #define MODBUS_ADDRESS_PV_CURRENT 0x3101
@@ -0,0 +1,94 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#ifndef EPEVER_MODEL_TRAITS_H
+#define EPEVER_MODEL_TRAITS_H
+
+#include "../../incl/include_all_core.h"
+
+/**
+ * Outcome of the boot probe, see EPEVERSolarTracer::detectModel()
+ */
+struct EPEVERProbeResult {
+        // 0x3004: rated voltage to battery (V * 100)
+        uint16_t ratedVoltage;
+        // 0x3005: rated charging current (A * 100)
+        uint16_t ratedChargingCurrent;
+        // 0x300E: rated load current (A * 100)
+        uint16_t ratedLoadCurrent;
+        bool hasTemperatureBlock;
+        bool hasBatterySocBlock;
+        bool hasBatteryOverallCurrent;
+        bool hasLoadOutput;
+        bool hasChargingSwitch;
+        bool hasBatterySettingsBlock;
+        bool hasBatteryRatedLevel;
+        bool hasChargingDurationBlock;
+};
+
+/**
+ * Register map of an EPEVER controller.
+ *
+ * Tracer A/B, Triton and Xtra share the same map: every block is available.
+ * With EPEVER_SOLAR_TRACER_AUTO the blocks are confirmed by the boot probe,
+ * a missing block is never polled and the variables it carries stay disabled.
+ */
+struct EPEVERTraits {
+        // 0x3110 - 0x3112: battery, controller and heatsink temperature
+        static bool hasTemperatureBlock;
+        // 0x311A - 0x311B: battery SOC, remote battery temperature
+        static bool hasBatterySocBlock;
+        // 0x331B - 0x331C: battery overall current
+        static bool hasBatteryOverallCurrent;
+        // coil 0x0002: load output switch
+        static bool hasLoadOutput;
+        // coil 0x0000: charging switch
+        static bool hasChargingSwitch;
+        // 0x9000 - 0x900E: battery type, capacity and voltage settings
+        static bool hasBatterySettingsBlock;
+        // battery settings can be written back to the controller
+        static constexpr bool isBatterySettingsWritable = true;
+        // registers to be written at once when changing a battery setting (0: single register write allowed)
+        static constexpr uint8_t batterySettingsWriteBlockSize = 15;
+        // 0x9067: battery rated voltage level
+        static bool hasBatteryRatedLevel;
+        // 0x906B - 0x9070: equalize/boost duration, battery management mode
+        static bool hasChargingDurationBlock;
+        // duration and management mode can be written back to the controller
+        static constexpr bool isChargingDurationWritable = true;
+        // register map is resolved at runtime by probing the controller
+        static constexpr bool isDetectedAtBoot = SOLAR_TRACER_MODEL == EPEVER_SOLAR_TRACER_AUTO;
+
+        static void applyProbeResult(const EPEVERProbeResult &result) {
+            hasTemperatureBlock = result.hasTemperatureBlock;
+            hasBatterySocBlock = result.hasBatterySocBlock;
+            hasBatteryOverallCurrent = result.hasBatteryOverallCurrent;
+            hasLoadOutput = result.hasLoadOutput;
+            hasChargingSwitch = result.hasChargingSwitch;
+            hasBatterySettingsBlock = result.hasBatterySettingsBlock;
+            hasBatteryRatedLevel = result.hasBatteryRatedLevel;
+            hasChargingDurationBlock = result.hasChargingDurationBlock;
+        }
+};
+
+#endif
@@ -5,7 +5,7 @@
 
 #include "LoadCurrentOverwrite.h"
 
-float LoadCurrentOverwrite::totalLoadEnergy = 0;
+SolarTracer *LoadCurrentOverwrite::tracer = nullptr;
 LinearSensHallCurrent *LoadCurrentOverwrite::sensor = nullptr;
 #ifdef USE_EXTERNAL_HEAVY_LOAD_CURRENT_METER_ADS1015_ADC
 ADS1015 *LoadCurrentOverwrite::ads1015 = nullptr;
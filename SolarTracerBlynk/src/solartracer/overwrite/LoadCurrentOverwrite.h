@@ -31,11 +31,16 @@
 #include "../../core/Environment.h"
 #include "../../incl/include_all_lib.h"
 #include "../SolarTracer.h"
+#include "LoadEnergyJournal.h"
+
+#ifndef EXTERNAL_HEAVY_LOAD_CURRENT_METER_UPDATE_MS_PERIOD
+#define EXTERNAL_HEAVY_LOAD_CURRENT_METER_UPDATE_MS_PERIOD CONTROLLER_UPDATE_MS_PERIOD
+#endif
 
 class LoadCurrentOverwrite {
     public:
         static void setup(SolarTracer *tracer) {
-            totalLoadEnergy = 0;
+            LoadCurrentOverwrite::tracer = tracer;
             lastRunMillis = 0;
 
 #ifdef USE_EXTERNAL_HEAVY_LOAD_CURRENT_METER_ADS1015_ADC
@@ -65,9 +70,20 @@ class LoadCurrentOverwrite {
             tracer->setVariableOverWritten(Variable::CONSUMED_ENERGY_YEAR, tracer->isVariableEnabled(Variable::BATTERY_VOLTAGE));
             tracer->setVariableOverWritten(Variable::CONSUMED_ENERGY_TOTAL, tracer->isVariableEnabled(Variable::BATTERY_VOLTAGE));
             tracer->setVariableOverWritten(Variable::BATTERY_OVERALL_CURRENT, tracer->isVariableEnabled(Variable::BATTERY_CHARGE_CURRENT));
+
+            if (tracer->isVariableEnabled(Variable::BATTERY_VOLTAGE)) {
+                LoadEnergyJournal::setup();
+                updateConsumedEnergy();
+            }
+
+            // values depending on the tracer ones are refreshed only when those change
+            tracer->subscribe(2, onTracerVariableChanged, Variable::BATTERY_CHARGE_CURRENT, Variable::BATTERY_VOLTAGE);
         }
 
-        static void overWrite(SolarTracer *tracer) {
+        /**
+         * Read the load current and update the values depending on it, to be called every EXTERNAL_HEAVY_LOAD_CURRENT_METER_UPDATE_MS_PERIOD
+         */
+        static void overWrite() {
             float current = sensor->readCurrent();
             if (current > 1000) {
                 // not happening
@@ -77,42 +93,64 @@ class LoadCurrentOverwrite {
                 // loads do not produce any current, must be a false reading
                 current = 0;
             }
-            tracer->setVariableValue(Variable::LOAD_CURRENT, &current, true);
+            tracer->set<Variable::LOAD_CURRENT>(current, true);
+            updateOverallCurrent();
 
-            if (tracer->isVariableReadReady(Variable::BATTERY_CHARGE_CURRENT)) {
-                const void *chargingCurrent = tracer->getValue(Variable::BATTERY_CHARGE_CURRENT);
-                float overallCurrent = *(float *)chargingCurrent - current;
-                tracer->setVariableValue(Variable::BATTERY_OVERALL_CURRENT, &overallCurrent, true);
-            }
-
-            const void *loadVoltage = tracer->getValue(Variable::BATTERY_VOLTAGE);
-
-            if (!tracer->isVariableReadReady(Variable::BATTERY_VOLTAGE) || loadVoltage == nullptr) {
+            if (!tracer->isVariableReadReady(Variable::BATTERY_VOLTAGE)) {
                 return;
             }
 
             unsigned long currentRunMillis = millis();
 
-            float loadPower = current * *((float *)loadVoltage);
+            float loadPower = updateLoadPower();
             float loadEnergy = lastRunMillis > 0 ? (currentRunMillis - lastRunMillis) / 3600000000.0 * loadPower : 0;
             lastRunMillis = currentRunMillis;
 
-            tracer->setVariableValue(Variable::LOAD_POWER, &loadPower, true);
-
-            totalLoadEnergy += loadEnergy;
-            tracer->setVariableValue(Variable::CONSUMED_ENERGY_TODAY, &totalLoadEnergy, true);
-            tracer->setVariableValue(Variable::CONSUMED_ENERGY_MONTH, &totalLoadEnergy, true);
-            tracer->setVariableValue(Variable::CONSUMED_ENERGY_YEAR, &totalLoadEnergy, true);
-            tracer->setVariableValue(Variable::CONSUMED_ENERGY_TOTAL, &totalLoadEnergy, true);
+            LoadEnergyJournal::add(loadEnergy);
+            updateConsumedEnergy();
         }
 
     private:
-        static float totalLoadEnergy;
+        static SolarTracer *tracer;
         static LinearSensHallCurrent *sensor;
 #ifdef USE_EXTERNAL_HEAVY_LOAD_CURRENT_METER_ADS1015_ADC
         static ADS1015 *ads1015;
 #endif
         static unsigned long lastRunMillis;
+
+        static void onTracerVariableChanged(Variable variable, const void *oldValue, const void *newValue) {
+            switch (variable) {
+                case Variable::BATTERY_CHARGE_CURRENT:
+                    updateOverallCurrent();
+                    break;
+                case Variable::BATTERY_VOLTAGE:
+                    updateLoadPower();
+                    break;
+            }
+        }
+
+        static void updateOverallCurrent() {
+            if (tracer->isVariableReadReady(Variable::BATTERY_CHARGE_CURRENT) && tracer->isVariableReadReady(Variable::LOAD_CURRENT)) {
+                tracer->set<Variable::BATTERY_OVERALL_CURRENT>(tracer->get<Variable::BATTERY_CHARGE_CURRENT>() - tracer->get<Variable::LOAD_CURRENT>(), true);
+            }
+        }
+
+        static void updateConsumedEnergy() {
+            const LoadEnergyRecord *counters = LoadEnergyJournal::getCounters();
+            tracer->set<Variable::CONSUMED_ENERGY_TODAY>(counters->today, true);
+            tracer->set<Variable::CONSUMED_ENERGY_MONTH>(counters->thisMonth, true);
+            tracer->set<Variable::CONSUMED_ENERGY_YEAR>(counters->thisYear, true);
+            tracer->set<Variable::CONSUMED_ENERGY_TOTAL>(counters->total, true);
+        }
+
+        static float updateLoadPower() {
+            float loadPower = 0;
+            if (tracer->isVariableReadReady(Variable::BATTERY_VOLTAGE) && tracer->isVariableReadReady(Variable::LOAD_CURRENT)) {
+                loadPower = tracer->get<Variable::LOAD_CURRENT>() * tracer->get<Variable::BATTERY_VOLTAGE>();
+                tracer->set<Variable::LOAD_POWER>(loadPower, true);
+            }
+            return loadPower;
+        }
 };
 
 #endif
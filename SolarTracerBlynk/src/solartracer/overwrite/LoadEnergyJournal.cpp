@@ -0,0 +1,143 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../incl/include_all_core.h"
+
+#ifdef USE_EXTERNAL_HEAVY_LOAD_CURRENT_METER
+
+#include "LoadEnergyJournal.h"
+
+#include <stddef.h>
+
+#include "../../core/datetime.h"
+#include "../../incl/include_all_lib.h"
+
+LoadEnergyRecord LoadEnergyJournal::counters = {};
+uint16_t LoadEnergyJournal::journalRecords = 0;
+unsigned long LoadEnergyJournal::lastCheckpointMillis = 0;
+
+void LoadEnergyJournal::setup() {
+    counters = {};
+    journalRecords = 0;
+
+    if (LittleFS.begin()) {
+        // compacted journal complete but not renamed yet
+        if (!LittleFS.exists(LOAD_ENERGY_JOURNAL_PERSISTENCE) && LittleFS.exists(LOAD_ENERGY_JOURNAL_COMPACT_PERSISTENCE)) {
+            LittleFS.rename(LOAD_ENERGY_JOURNAL_COMPACT_PERSISTENCE, LOAD_ENERGY_JOURNAL_PERSISTENCE);
+        }
+        if (LittleFS.exists(LOAD_ENERGY_JOURNAL_PERSISTENCE)) {
+            File journalFile = LittleFS.open(LOAD_ENERGY_JOURNAL_PERSISTENCE, "r");
+            if (journalFile) {
+                // the last valid record wins, a torn write at the end is skipped
+                LoadEnergyRecord record;
+                while (journalFile.read((uint8_t *)&record, sizeof(LoadEnergyRecord)) == sizeof(LoadEnergyRecord)) {
+                    journalRecords++;
+                    if (record.magic == LOAD_ENERGY_JOURNAL_MAGIC && record.checksum == getChecksum(&record)) {
+                        counters = record;
+                    }
+                }
+                journalFile.close();
+            }
+        }
+        LittleFS.end();
+    }
+
+    // set up before the NTP time: a reboot across midnight is rolled over by the first add()
+    lastCheckpointMillis = millis();
+}
+
+void LoadEnergyJournal::add(float energy) {
+    bool dateChanged = rollOver();
+
+    counters.today += energy;
+    counters.thisMonth += energy;
+    counters.thisYear += energy;
+    counters.total += energy;
+
+    if (dateChanged || millis() - lastCheckpointMillis >= EXTERNAL_HEAVY_LOAD_ENERGY_CHECKPOINT_MS_PERIOD) {
+        checkpoint();
+    }
+}
+
+bool LoadEnergyJournal::rollOver() {
+    struct tm *ti = Datetime::getMyNowTm();
+    if (ti == nullptr) {
+        // no local time: keep counting
+        return false;
+    }
+    if (counters.dateYear == ti->tm_year && counters.dateYday == ti->tm_yday) {
+        return false;
+    }
+
+    // counters restored without a date are assumed to be of the current period
+    if (counters.dateYear != 0) {
+        if (counters.dateYear != ti->tm_year) {
+            counters.thisYear = 0;
+            counters.thisMonth = 0;
+        } else if (counters.dateMonth != ti->tm_mon) {
+            counters.thisMonth = 0;
+        }
+        counters.today = 0;
+    }
+    counters.dateYear = ti->tm_year;
+    counters.dateMonth = ti->tm_mon;
+    counters.dateYday = ti->tm_yday;
+    return true;
+}
+
+void LoadEnergyJournal::checkpoint() {
+    lastCheckpointMillis = millis();
+    counters.magic = LOAD_ENERGY_JOURNAL_MAGIC;
+    counters.checksum = getChecksum(&counters);
+
+    if (!LittleFS.begin()) {
+        return;
+    }
+    bool compact = journalRecords >= EXTERNAL_HEAVY_LOAD_ENERGY_JOURNAL_MAX_RECORDS;
+    // a full journal is replaced by one with just the last record, the old one is kept until the new one is complete
+    File journalFile = LittleFS.open(compact ? LOAD_ENERGY_JOURNAL_COMPACT_PERSISTENCE : LOAD_ENERGY_JOURNAL_PERSISTENCE, compact ? "w" : "a");
+    if (journalFile) {
+        bool written = journalFile.write((const uint8_t *)&counters, sizeof(LoadEnergyRecord)) == sizeof(LoadEnergyRecord);
+        journalFile.close();
+        // the rename replaces the old journal atomically
+        if (written && compact && LittleFS.rename(LOAD_ENERGY_JOURNAL_COMPACT_PERSISTENCE, LOAD_ENERGY_JOURNAL_PERSISTENCE)) {
+            journalRecords = 0;
+        }
+        journalRecords += written ? 1 : 0;
+    } else {
+        debugPrintln("ERROR: cannot write load energy journal");
+    }
+    LittleFS.end();
+}
+
+uint16_t LoadEnergyJournal::getChecksum(const LoadEnergyRecord *record) {
+    // Fletcher-16 of the record content
+    uint16_t sum1 = 0;
+    uint16_t sum2 = 0;
+    const uint8_t *data = (const uint8_t *)record;
+    for (uint8_t index = 0; index < offsetof(LoadEnergyRecord, checksum); index++) {
+        sum1 = (sum1 + data[index]) % 255;
+        sum2 = (sum2 + sum1) % 255;
+    }
+    return (sum2 << 8) | sum1;
+}
+
+#endif
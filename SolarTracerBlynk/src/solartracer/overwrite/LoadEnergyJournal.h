@@ -0,0 +1,102 @@
+/**
+ * Solar Tracer Blynk V3 [https://github.com/Bettapro/Solar-Tracer-Blynk-V3]
+ * Copyright (c) 2021 Alberto Bettin
+ *
+ * Based on the work of @jaminNZx and @tekk.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#ifndef LOAD_ENERGY_JOURNAL_H
+#define LOAD_ENERGY_JOURNAL_H
+
+#include "../../incl/include_all_core.h"
+
+#ifdef USE_EXTERNAL_HEAVY_LOAD_CURRENT_METER
+
+#define LOAD_ENERGY_JOURNAL_PERSISTENCE "/load_energy.jrn"
+#define LOAD_ENERGY_JOURNAL_COMPACT_PERSISTENCE "/load_energy.tmp"
+#define LOAD_ENERGY_JOURNAL_MAGIC 0x4C45
+
+// ms between 2 checkpoints, energy consumed after the last one is lost on reboot
+#ifndef EXTERNAL_HEAVY_LOAD_ENERGY_CHECKPOINT_MS_PERIOD
+#define EXTERNAL_HEAVY_LOAD_ENERGY_CHECKPOINT_MS_PERIOD 1800000L
+#endif
+// records appended before the journal is compacted into a single one
+#ifndef EXTERNAL_HEAVY_LOAD_ENERGY_JOURNAL_MAX_RECORDS
+#define EXTERNAL_HEAVY_LOAD_ENERGY_JOURNAL_MAX_RECORDS 128
+#endif
+
+/**
+ * Checkpoint of the energy counters
+ */
+struct LoadEnergyRecord {
+        uint16_t magic;
+        // local date of the counters (tm_year, tm_mon, tm_yday), dateYear is 0 if the time was unknown
+        uint16_t dateYear;
+        uint16_t dateYday;
+        uint8_t dateMonth;
+        uint8_t reserved;
+        // kWh
+        float today;
+        float thisMonth;
+        float thisYear;
+        float total;
+        uint16_t checksum;
+};
+
+/**
+ * Energy consumed by the load, kept across reboots.
+ *
+ * Checkpoints are appended to a journal in LittleFS (one record every
+ * EXTERNAL_HEAVY_LOAD_ENERGY_CHECKPOINT_MS_PERIOD and at each day change),
+ * the journal is rewritten only every EXTERNAL_HEAVY_LOAD_ENERGY_JOURNAL_MAX_RECORDS
+ * records. Counters roll over at the local day/month/year change.
+ */
+class LoadEnergyJournal {
+    public:
+        /**
+         * Restore the counters from the last valid checkpoint
+         */
+        static void setup();
+
+        /**
+         * Add the energy (kWh) consumed since the last call
+         */
+        static void add(float energy);
+
+        static inline const LoadEnergyRecord *getCounters() {
+            return &counters;
+        }
+
+    private:
+        static LoadEnergyRecord counters;
+        static uint16_t journalRecords;
+        static unsigned long lastCheckpointMillis;
+
+        /**
+         * Reset the counters of the periods that are over, true if the date changed
+         */
+        static bool rollOver();
+
+        static void checkpoint();
+
+        static uint16_t getChecksum(const LoadEnergyRecord *record);
+};
+
+#endif
+#endif